@@ -0,0 +1,177 @@
+#ifndef CANON_C_ALGO_EYTZINGER_H
+#define CANON_C_ALGO_EYTZINGER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "core/arena.h"
+#include "core/memory_bulk.h"
+
+/*
+    eytzinger.h — Static search index in Eytzinger (BFS) layout
+
+    A sorted array is copied into breadth-first order of its implicit
+    binary search tree: node k has children 2k and 2k+1 (1-based).
+    The first levels of every search share a few cache lines, and the
+    nodes visited next are always at a predictable place, so a search
+    can prefetch several levels ahead — unlike a plain sorted array,
+    where every probe of a large array is a separate cache miss.
+
+    Lookups are branchless (fixed step count for a given len) and
+    return indices into the ORIGINAL sorted array: the index keeps,
+    for each tree node, the position its key came from.
+
+    Build once, query many times; the index is read-only afterwards.
+    Memory: (len + 1) keys and (len + 1) size_t positions, from caller
+    buffers or an Arena. For the best prefetching, the key buffer
+    should start on a MEM_CACHE_LINE boundary (the Arena build does this).
+*/
+
+/* Follow the in-order successor of node k in a tree of n nodes */
+static inline size_t algo_eytzinger_next_(size_t k, size_t n)
+{
+    if (2 * k + 1 <= n) {
+        k = 2 * k + 1;
+        while (2 * k <= n) k *= 2;
+        return k;
+    }
+    while (k & 1) k >>= 1;
+    return k >> 1;
+}
+
+/* Leftmost (smallest) node of a tree of n >= 1 nodes */
+static inline size_t algo_eytzinger_first_(size_t n)
+{
+    size_t k = 1;
+    while (2 * k <= n) k *= 2;
+    return k;
+}
+
+/*
+   After a descent ends at k > n, the answer is the last node where the
+   search went left: drop the trailing 1-bits (right turns) and one more.
+   0 means the search never went left (key beyond every element).
+*/
+static inline size_t algo_eytzinger_settle_(size_t k)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return k >> (__builtin_ctzll(~(unsigned long long)k) + 1);
+#else
+    while (k & 1) k >>= 1;
+    return k >> 1;
+#endif
+}
+
+/* Elements per cache line (at least 1): prefetch distance multiplier */
+#define ALGO_EYTZINGER_BLOCK(Type) \
+    (sizeof(Type) < MEM_CACHE_LINE ? MEM_CACHE_LINE / sizeof(Type) : 1)
+
+/*
+    DEFINE_EYTZINGER(Type, less_expr)
+      less_expr is evaluated with `a` and `b` bound to `const Type*`
+      (same as DEFINE_SORT / DEFINE_SEARCH). Generates:
+
+        typedef struct { Type* keys; size_t* index; size_t len; } eytzinger_##Type;
+
+        bool eytzinger_##Type##_init(e, sorted, len, keys_buf, index_buf)
+          keys_buf: len + 1 Types, index_buf: len + 1 size_t
+        bool eytzinger_##Type##_init_arena(e, sorted, len, arena)
+
+        size_t eytzinger_##Type##_lower_bound(e, key)  first pos with !(elem < key), or len
+        size_t eytzinger_##Type##_upper_bound(e, key)  first pos with key < elem, or len
+        size_t eytzinger_##Type##_find(e, key)         pos of first match or SIZE_MAX
+        bool   eytzinger_##Type##_contains(e, key)
+
+      Positions refer to the sorted array the index was built from.
+*/
+#define DEFINE_EYTZINGER(Type, less_expr) \
+typedef struct { \
+    Type* keys;     /* keys[1..len] in BFS order (keys[0] unused) */ \
+    size_t* index;  /* index[k] = position of keys[k] in the sorted input */ \
+    size_t len; \
+} eytzinger_##Type; \
+\
+static inline bool eytzinger_##Type##_less_(const Type* a, const Type* b) \
+{ \
+    return (less_expr); \
+} \
+\
+static inline bool eytzinger_##Type##_init( \
+    eytzinger_##Type* e, const Type* sorted, size_t len, Type* keys_buf, size_t* index_buf) \
+{ \
+    if (!e || (len > 0 && (!sorted || !keys_buf || !index_buf))) return false; \
+    *e = (eytzinger_##Type){ .keys = keys_buf, .index = index_buf, .len = len }; \
+    if (len == 0) return true; \
+    size_t k = algo_eytzinger_first_(len); \
+    for (size_t i = 0; i < len; ++i) { \
+        keys_buf[k] = sorted[i]; \
+        index_buf[k] = i; \
+        k = algo_eytzinger_next_(k, len); \
+    } \
+    return true; \
+} \
+\
+static inline bool eytzinger_##Type##_init_arena( \
+    eytzinger_##Type* e, const Type* sorted, size_t len, Arena* arena) \
+{ \
+    if (!e || !arena || len >= SIZE_MAX / sizeof(Type) || len >= SIZE_MAX / sizeof(size_t)) return false; \
+    ArenaMark mark = arena_mark(arena); \
+    size_t align = _Alignof(Type) > MEM_CACHE_LINE ? _Alignof(Type) : MEM_CACHE_LINE; \
+    /* Rounded size keeps the arena offset aligned for the next allocation */ \
+    Type* keys = (Type*)arena_alloc_aligned(arena, mem_align((len + 1) * sizeof(Type)), align); \
+    size_t* index = arena_alloc_array(arena, size_t, len + 1); \
+    if (!keys || !index) { \
+        arena_reset_to(arena, mark); \
+        return false; \
+    } \
+    return eytzinger_##Type##_init(e, sorted, len, keys, index); \
+} \
+\
+static inline size_t eytzinger_##Type##_lower_bound(const eytzinger_##Type* e, const Type* key) \
+{ \
+    if (!e || e->len == 0) return 0; \
+    const size_t block = ALGO_EYTZINGER_BLOCK(Type); \
+    const Type* keys = e->keys; \
+    size_t n = e->len, k = 1; \
+    while (k <= n) { \
+        mem_prefetch((const void*)((uintptr_t)keys + k * block * sizeof(Type))); \
+        k = 2 * k + eytzinger_##Type##_less_(&keys[k], key); \
+    } \
+    k = algo_eytzinger_settle_(k); \
+    return k ? e->index[k] : n; \
+} \
+\
+static inline size_t eytzinger_##Type##_upper_bound(const eytzinger_##Type* e, const Type* key) \
+{ \
+    if (!e || e->len == 0) return 0; \
+    const size_t block = ALGO_EYTZINGER_BLOCK(Type); \
+    const Type* keys = e->keys; \
+    size_t n = e->len, k = 1; \
+    while (k <= n) { \
+        mem_prefetch((const void*)((uintptr_t)keys + k * block * sizeof(Type))); \
+        k = 2 * k + !eytzinger_##Type##_less_(key, &keys[k]); \
+    } \
+    k = algo_eytzinger_settle_(k); \
+    return k ? e->index[k] : n; \
+} \
+\
+static inline size_t eytzinger_##Type##_find(const eytzinger_##Type* e, const Type* key) \
+{ \
+    if (!e || e->len == 0) return SIZE_MAX; \
+    const size_t block = ALGO_EYTZINGER_BLOCK(Type); \
+    const Type* keys = e->keys; \
+    size_t n = e->len, k = 1; \
+    while (k <= n) { \
+        mem_prefetch((const void*)((uintptr_t)keys + k * block * sizeof(Type))); \
+        k = 2 * k + eytzinger_##Type##_less_(&keys[k], key); \
+    } \
+    k = algo_eytzinger_settle_(k); \
+    return (k && !eytzinger_##Type##_less_(key, &keys[k])) ? e->index[k] : SIZE_MAX; \
+} \
+\
+static inline bool eytzinger_##Type##_contains(const eytzinger_##Type* e, const Type* key) \
+{ \
+    return eytzinger_##Type##_find(e, key) != SIZE_MAX; \
+}
+
+#endif /* CANON_C_ALGO_EYTZINGER_H */
@@ -14,6 +14,11 @@
       Preserves relative order.
       Truncates if output capacity is insufficient.
 
+    algo_retain:
+      In-place variant: keeps the elements that satisfy pred at the front
+      of the array, in order, and returns the new length.
+      No second buffer, one pass of reads and writes.
+
     Properties:
       - Read-only input
       - No allocation, mutation, or ownership transfer
@@ -54,6 +59,34 @@ static inline size_t algo_filter_into(
     return out_len;
 }
 
+/*
+    algo_retain:
+      Stable in-place filter over an array of elem_size-byte elements.
+      Returns the number of elements kept (the new length).
+      Returns 0 on invalid input (array == NULL || pred == NULL).
+*/
+static inline size_t algo_retain(
+    void* array,
+    size_t len,
+    size_t elem_size,
+    algo_filter_pred pred,
+    void* ctx
+)
+{
+    if (!array || !pred || elem_size == 0) return 0;
+
+    char* bytes = (char*)array;
+    size_t kept = 0;
+    for (size_t i = 0; i < len; ++i) {
+        const char* elem = bytes + i * elem_size;
+        if (pred(elem, ctx)) {
+            if (kept != i) mem_copy(bytes + kept * elem_size, elem, elem_size);
+            ++kept;
+        }
+    }
+    return kept;
+}
+
 /* ============================================================
    Strongly typed version (recommended)
    ============================================================ */
@@ -77,6 +110,28 @@ static inline size_t algo_filter_into(
         _out_len; \
     })
 
+/*
+    ALGO_RETAIN_TYPED(array, len, Type, pred, ctx)
+      pred signature: bool pred(const Type* elem, void* ctx)
+      Stable in-place filter; returns the new length.
+      Branchless: every element is written to the next slot and the
+      slot only advances when pred holds.
+*/
+#define ALGO_RETAIN_TYPED(array, len, Type, pred, ctx) \
+    ({ \
+        size_t _kept = 0; \
+        if ((array) && (pred)) { \
+            Type* _a = (array); \
+            const size_t _len = (len); \
+            for (size_t _i = 0; _i < _len; ++_i) { \
+                Type _x = _a[_i]; \
+                _a[_kept] = _x; \
+                _kept += (pred)(&_x, (ctx)) ? 1u : 0u; \
+            } \
+        } \
+        _kept; \
+    })
+
 /* ============================================================
    Vec integration (safe bounded filtering)
    ============================================================ */
@@ -91,4 +146,12 @@ static inline size_t algo_filter_into(
         ctx \
     )
 
+/* In-place: keeps matching elements of vec (in order) and updates vec.len */
+#define ALGO_RETAIN_VEC(vec, Type, pred, ctx) \
+    do { \
+        if ((vec).items) { \
+            (vec).len = ALGO_RETAIN_TYPED((vec).items, (vec).len, Type, pred, ctx); \
+        } \
+    } while (0)
+
 #endif /* CANON_C_ALGO_FILTER_H */
@@ -0,0 +1,457 @@
+#ifndef CANON_C_ALGO_FILTER_SIMD_H
+#define CANON_C_ALGO_FILTER_SIMD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "core/cpu.h"
+
+/*
+    filter_simd.h — Vectorized filters for numeric columns
+
+    Companion to filter.h for the common case of primitive arrays and a
+    comparison predicate. Each block of elements is compared at once into
+    a lane mask, then the matching lanes are packed to the output:
+      - AVX-512F: compress-store
+      - AVX2:     permute with a lookup table indexed by the mask
+      - scalar:   branchless copy-and-advance (any target)
+    The ISA is chosen at run time (cpu.h).
+
+    algo_filter_i32 / _i64 / _f32 / _f64(in, len, op, a, b, out, out_cap):
+      Copies the elements x of `in` for which `x op a` holds into `out`,
+      preserving order; returns the number written.
+      Truncates when out_cap is reached (like algo_filter_into).
+      out may equal in (in-place compaction); other overlap is not allowed.
+      Returns 0 on invalid input or an op the type does not support.
+
+    Floating-point comparisons follow C: NaN matches only ALGO_FILTER_NE.
+*/
+
+typedef enum {
+    ALGO_FILTER_EQ,       /* x == a */
+    ALGO_FILTER_NE,       /* x != a */
+    ALGO_FILTER_LT,       /* x <  a */
+    ALGO_FILTER_LE,       /* x <= a */
+    ALGO_FILTER_GT,       /* x >  a */
+    ALGO_FILTER_GE,       /* x >= a */
+    ALGO_FILTER_BETWEEN,  /* a <= x && x <= b */
+    ALGO_FILTER_MASK_EQ   /* (x & a) == b  (integers only) */
+} AlgoFilterOp;
+
+/* ============================================================
+   Scalar predicates (internal)
+   ============================================================ */
+
+#define ALGO_FILTER_MATCH_CMP_(x, op, a, b) \
+    ((op) == ALGO_FILTER_EQ ? (x) == (a) : \
+     (op) == ALGO_FILTER_NE ? (x) != (a) : \
+     (op) == ALGO_FILTER_LT ? (x) <  (a) : \
+     (op) == ALGO_FILTER_LE ? (x) <= (a) : \
+     (op) == ALGO_FILTER_GT ? (x) >  (a) : \
+     (op) == ALGO_FILTER_GE ? (x) >= (a) : \
+     ((a) <= (x) && (x) <= (b)))
+
+static inline bool algo_filter_match_i32_(int32_t x, AlgoFilterOp op, int32_t a, int32_t b)
+{
+    return op == ALGO_FILTER_MASK_EQ ? (x & a) == b : ALGO_FILTER_MATCH_CMP_(x, op, a, b);
+}
+
+static inline bool algo_filter_match_i64_(int64_t x, AlgoFilterOp op, int64_t a, int64_t b)
+{
+    return op == ALGO_FILTER_MASK_EQ ? (x & a) == b : ALGO_FILTER_MATCH_CMP_(x, op, a, b);
+}
+
+static inline bool algo_filter_match_f32_(float x, AlgoFilterOp op, float a, float b)
+{
+    return ALGO_FILTER_MATCH_CMP_(x, op, a, b);
+}
+
+static inline bool algo_filter_match_f64_(double x, AlgoFilterOp op, double a, double b)
+{
+    return ALGO_FILTER_MATCH_CMP_(x, op, a, b);
+}
+
+static inline bool algo_filter_op_valid_(AlgoFilterOp op, bool is_integer)
+{
+    return (unsigned)op <= (unsigned)ALGO_FILTER_BETWEEN || (is_integer && op == ALGO_FILTER_MASK_EQ);
+}
+
+/* ============================================================
+   SIMD kernels (internal, x86-64 only)
+   Each returns the number of input elements consumed and advances *n;
+   it stops while a full vector still fits in the output.
+   ============================================================ */
+
+#if CANON_C_X86_SIMD
+
+/*
+   Compaction tables for AVX2: for a lane mask m, entry m holds the
+   indices of the set lanes, one per nibble, lowest lane first.
+   8-lane table for 32-bit elements; 4-lane table (as 32-bit lane pairs)
+   for 64-bit elements.
+*/
+static const uint32_t algo_filter_lut8_[256] = {
+    0x00000000, 0x00000000, 0x00000001, 0x00000010, 0x00000002, 0x00000020, 0x00000021, 0x00000210,
+    0x00000003, 0x00000030, 0x00000031, 0x00000310, 0x00000032, 0x00000320, 0x00000321, 0x00003210,
+    0x00000004, 0x00000040, 0x00000041, 0x00000410, 0x00000042, 0x00000420, 0x00000421, 0x00004210,
+    0x00000043, 0x00000430, 0x00000431, 0x00004310, 0x00000432, 0x00004320, 0x00004321, 0x00043210,
+    0x00000005, 0x00000050, 0x00000051, 0x00000510, 0x00000052, 0x00000520, 0x00000521, 0x00005210,
+    0x00000053, 0x00000530, 0x00000531, 0x00005310, 0x00000532, 0x00005320, 0x00005321, 0x00053210,
+    0x00000054, 0x00000540, 0x00000541, 0x00005410, 0x00000542, 0x00005420, 0x00005421, 0x00054210,
+    0x00000543, 0x00005430, 0x00005431, 0x00054310, 0x00005432, 0x00054320, 0x00054321, 0x00543210,
+    0x00000006, 0x00000060, 0x00000061, 0x00000610, 0x00000062, 0x00000620, 0x00000621, 0x00006210,
+    0x00000063, 0x00000630, 0x00000631, 0x00006310, 0x00000632, 0x00006320, 0x00006321, 0x00063210,
+    0x00000064, 0x00000640, 0x00000641, 0x00006410, 0x00000642, 0x00006420, 0x00006421, 0x00064210,
+    0x00000643, 0x00006430, 0x00006431, 0x00064310, 0x00006432, 0x00064320, 0x00064321, 0x00643210,
+    0x00000065, 0x00000650, 0x00000651, 0x00006510, 0x00000652, 0x00006520, 0x00006521, 0x00065210,
+    0x00000653, 0x00006530, 0x00006531, 0x00065310, 0x00006532, 0x00065320, 0x00065321, 0x00653210,
+    0x00000654, 0x00006540, 0x00006541, 0x00065410, 0x00006542, 0x00065420, 0x00065421, 0x00654210,
+    0x00006543, 0x00065430, 0x00065431, 0x00654310, 0x00065432, 0x00654320, 0x00654321, 0x06543210,
+    0x00000007, 0x00000070, 0x00000071, 0x00000710, 0x00000072, 0x00000720, 0x00000721, 0x00007210,
+    0x00000073, 0x00000730, 0x00000731, 0x00007310, 0x00000732, 0x00007320, 0x00007321, 0x00073210,
+    0x00000074, 0x00000740, 0x00000741, 0x00007410, 0x00000742, 0x00007420, 0x00007421, 0x00074210,
+    0x00000743, 0x00007430, 0x00007431, 0x00074310, 0x00007432, 0x00074320, 0x00074321, 0x00743210,
+    0x00000075, 0x00000750, 0x00000751, 0x00007510, 0x00000752, 0x00007520, 0x00007521, 0x00075210,
+    0x00000753, 0x00007530, 0x00007531, 0x00075310, 0x00007532, 0x00075320, 0x00075321, 0x00753210,
+    0x00000754, 0x00007540, 0x00007541, 0x00075410, 0x00007542, 0x00075420, 0x00075421, 0x00754210,
+    0x00007543, 0x00075430, 0x00075431, 0x00754310, 0x00075432, 0x00754320, 0x00754321, 0x07543210,
+    0x00000076, 0x00000760, 0x00000761, 0x00007610, 0x00000762, 0x00007620, 0x00007621, 0x00076210,
+    0x00000763, 0x00007630, 0x00007631, 0x00076310, 0x00007632, 0x00076320, 0x00076321, 0x00763210,
+    0x00000764, 0x00007640, 0x00007641, 0x00076410, 0x00007642, 0x00076420, 0x00076421, 0x00764210,
+    0x00007643, 0x00076430, 0x00076431, 0x00764310, 0x00076432, 0x00764320, 0x00764321, 0x07643210,
+    0x00000765, 0x00007650, 0x00007651, 0x00076510, 0x00007652, 0x00076520, 0x00076521, 0x00765210,
+    0x00007653, 0x00076530, 0x00076531, 0x00765310, 0x00076532, 0x00765320, 0x00765321, 0x07653210,
+    0x00007654, 0x00076540, 0x00076541, 0x00765410, 0x00076542, 0x00765420, 0x00765421, 0x07654210,
+    0x00076543, 0x00765430, 0x00765431, 0x07654310, 0x00765432, 0x07654320, 0x07654321, 0x76543210,
+};
+
+static const uint32_t algo_filter_lut4_[16] = {
+    0x00000000, 0x00000010, 0x00000032, 0x00003210, 0x00000054, 0x00005410, 0x00005432, 0x00543210,
+    0x00000076, 0x00007610, 0x00007632, 0x00763210, 0x00007654, 0x00765410, 0x00765432, 0x76543210,
+};
+
+/* Unpack a table entry into a permutevar8x32 index vector */
+CANON_C_TARGET("avx2")
+static inline __m256i algo_filter_perm_avx2_(uint32_t packed)
+{
+    __m256i v = _mm256_set1_epi32((int)packed);
+    __m256i shifts = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+    return _mm256_and_si256(_mm256_srlv_epi32(v, shifts), _mm256_set1_epi32(7));
+}
+
+/* ---------- AVX2 lane masks ---------- */
+
+CANON_C_TARGET("avx2")
+static inline __m256i algo_filter_cmp_i32_avx2_(__m256i x, AlgoFilterOp op, __m256i va, __m256i vb)
+{
+    __m256i ones = _mm256_set1_epi32(-1);
+    switch (op) {
+    case ALGO_FILTER_EQ:      return _mm256_cmpeq_epi32(x, va);
+    case ALGO_FILTER_NE:      return _mm256_xor_si256(_mm256_cmpeq_epi32(x, va), ones);
+    case ALGO_FILTER_LT:      return _mm256_cmpgt_epi32(va, x);
+    case ALGO_FILTER_LE:      return _mm256_xor_si256(_mm256_cmpgt_epi32(x, va), ones);
+    case ALGO_FILTER_GT:      return _mm256_cmpgt_epi32(x, va);
+    case ALGO_FILTER_GE:      return _mm256_xor_si256(_mm256_cmpgt_epi32(va, x), ones);
+    case ALGO_FILTER_BETWEEN: return _mm256_andnot_si256(
+                                  _mm256_or_si256(_mm256_cmpgt_epi32(va, x), _mm256_cmpgt_epi32(x, vb)), ones);
+    case ALGO_FILTER_MASK_EQ: return _mm256_cmpeq_epi32(_mm256_and_si256(x, va), vb);
+    }
+    return _mm256_setzero_si256();
+}
+
+CANON_C_TARGET("avx2")
+static inline __m256i algo_filter_cmp_i64_avx2_(__m256i x, AlgoFilterOp op, __m256i va, __m256i vb)
+{
+    __m256i ones = _mm256_set1_epi32(-1);
+    switch (op) {
+    case ALGO_FILTER_EQ:      return _mm256_cmpeq_epi64(x, va);
+    case ALGO_FILTER_NE:      return _mm256_xor_si256(_mm256_cmpeq_epi64(x, va), ones);
+    case ALGO_FILTER_LT:      return _mm256_cmpgt_epi64(va, x);
+    case ALGO_FILTER_LE:      return _mm256_xor_si256(_mm256_cmpgt_epi64(x, va), ones);
+    case ALGO_FILTER_GT:      return _mm256_cmpgt_epi64(x, va);
+    case ALGO_FILTER_GE:      return _mm256_xor_si256(_mm256_cmpgt_epi64(va, x), ones);
+    case ALGO_FILTER_BETWEEN: return _mm256_andnot_si256(
+                                  _mm256_or_si256(_mm256_cmpgt_epi64(va, x), _mm256_cmpgt_epi64(x, vb)), ones);
+    case ALGO_FILTER_MASK_EQ: return _mm256_cmpeq_epi64(_mm256_and_si256(x, va), vb);
+    }
+    return _mm256_setzero_si256();
+}
+
+CANON_C_TARGET("avx2")
+static inline __m256 algo_filter_cmp_f32_avx2_(__m256 x, AlgoFilterOp op, __m256 va, __m256 vb)
+{
+    switch (op) {
+    case ALGO_FILTER_EQ:      return _mm256_cmp_ps(x, va, _CMP_EQ_OQ);
+    case ALGO_FILTER_NE:      return _mm256_cmp_ps(x, va, _CMP_NEQ_UQ);
+    case ALGO_FILTER_LT:      return _mm256_cmp_ps(x, va, _CMP_LT_OQ);
+    case ALGO_FILTER_LE:      return _mm256_cmp_ps(x, va, _CMP_LE_OQ);
+    case ALGO_FILTER_GT:      return _mm256_cmp_ps(x, va, _CMP_GT_OQ);
+    case ALGO_FILTER_GE:      return _mm256_cmp_ps(x, va, _CMP_GE_OQ);
+    case ALGO_FILTER_BETWEEN: return _mm256_and_ps(_mm256_cmp_ps(x, va, _CMP_GE_OQ),
+                                                   _mm256_cmp_ps(x, vb, _CMP_LE_OQ));
+    default:                  break;
+    }
+    return _mm256_setzero_ps();
+}
+
+CANON_C_TARGET("avx2")
+static inline __m256d algo_filter_cmp_f64_avx2_(__m256d x, AlgoFilterOp op, __m256d va, __m256d vb)
+{
+    switch (op) {
+    case ALGO_FILTER_EQ:      return _mm256_cmp_pd(x, va, _CMP_EQ_OQ);
+    case ALGO_FILTER_NE:      return _mm256_cmp_pd(x, va, _CMP_NEQ_UQ);
+    case ALGO_FILTER_LT:      return _mm256_cmp_pd(x, va, _CMP_LT_OQ);
+    case ALGO_FILTER_LE:      return _mm256_cmp_pd(x, va, _CMP_LE_OQ);
+    case ALGO_FILTER_GT:      return _mm256_cmp_pd(x, va, _CMP_GT_OQ);
+    case ALGO_FILTER_GE:      return _mm256_cmp_pd(x, va, _CMP_GE_OQ);
+    case ALGO_FILTER_BETWEEN: return _mm256_and_pd(_mm256_cmp_pd(x, va, _CMP_GE_OQ),
+                                                   _mm256_cmp_pd(x, vb, _CMP_LE_OQ));
+    default:                  break;
+    }
+    return _mm256_setzero_pd();
+}
+
+/* ---------- AVX2 kernels ---------- */
+
+CANON_C_TARGET("avx2")
+static inline size_t algo_filter_i32_avx2_(const int32_t* in, size_t len, AlgoFilterOp op,
+                                           int32_t a, int32_t b, int32_t* out, size_t out_cap, size_t* n)
+{
+    __m256i va = _mm256_set1_epi32(a), vb = _mm256_set1_epi32(b);
+    size_t i = 0, k = *n;
+    for (; i + 8 <= len && k + 8 <= out_cap; i += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(in + i));
+        unsigned m = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(algo_filter_cmp_i32_avx2_(x, op, va, vb)));
+        __m256i packed = _mm256_permutevar8x32_epi32(x, algo_filter_perm_avx2_(algo_filter_lut8_[m]));
+        _mm256_storeu_si256((__m256i*)(out + k), packed);
+        k += (size_t)__builtin_popcount(m);
+    }
+    *n = k;
+    return i;
+}
+
+CANON_C_TARGET("avx2")
+static inline size_t algo_filter_i64_avx2_(const int64_t* in, size_t len, AlgoFilterOp op,
+                                           int64_t a, int64_t b, int64_t* out, size_t out_cap, size_t* n)
+{
+    __m256i va = _mm256_set1_epi64x(a), vb = _mm256_set1_epi64x(b);
+    size_t i = 0, k = *n;
+    for (; i + 4 <= len && k + 4 <= out_cap; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(in + i));
+        unsigned m = (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(algo_filter_cmp_i64_avx2_(x, op, va, vb)));
+        __m256i packed = _mm256_permutevar8x32_epi32(x, algo_filter_perm_avx2_(algo_filter_lut4_[m]));
+        _mm256_storeu_si256((__m256i*)(out + k), packed);
+        k += (size_t)__builtin_popcount(m);
+    }
+    *n = k;
+    return i;
+}
+
+CANON_C_TARGET("avx2")
+static inline size_t algo_filter_f32_avx2_(const float* in, size_t len, AlgoFilterOp op,
+                                           float a, float b, float* out, size_t out_cap, size_t* n)
+{
+    __m256 va = _mm256_set1_ps(a), vb = _mm256_set1_ps(b);
+    size_t i = 0, k = *n;
+    for (; i + 8 <= len && k + 8 <= out_cap; i += 8) {
+        __m256 x = _mm256_loadu_ps(in + i);
+        unsigned m = (unsigned)_mm256_movemask_ps(algo_filter_cmp_f32_avx2_(x, op, va, vb));
+        __m256 packed = _mm256_permutevar8x32_ps(x, algo_filter_perm_avx2_(algo_filter_lut8_[m]));
+        _mm256_storeu_ps(out + k, packed);
+        k += (size_t)__builtin_popcount(m);
+    }
+    *n = k;
+    return i;
+}
+
+CANON_C_TARGET("avx2")
+static inline size_t algo_filter_f64_avx2_(const double* in, size_t len, AlgoFilterOp op,
+                                           double a, double b, double* out, size_t out_cap, size_t* n)
+{
+    __m256d va = _mm256_set1_pd(a), vb = _mm256_set1_pd(b);
+    size_t i = 0, k = *n;
+    for (; i + 4 <= len && k + 4 <= out_cap; i += 4) {
+        __m256d x = _mm256_loadu_pd(in + i);
+        unsigned m = (unsigned)_mm256_movemask_pd(algo_filter_cmp_f64_avx2_(x, op, va, vb));
+        __m256 packed = _mm256_permutevar8x32_ps(_mm256_castpd_ps(x),
+                                                 algo_filter_perm_avx2_(algo_filter_lut4_[m]));
+        _mm256_storeu_ps((float*)(out + k), packed);
+        k += (size_t)__builtin_popcount(m);
+    }
+    *n = k;
+    return i;
+}
+
+/* ---------- AVX-512 lane masks ---------- */
+
+CANON_C_TARGET("avx512f")
+static inline __mmask16 algo_filter_cmp_i32_avx512_(__m512i x, AlgoFilterOp op, __m512i va, __m512i vb)
+{
+    switch (op) {
+    case ALGO_FILTER_EQ:      return _mm512_cmpeq_epi32_mask(x, va);
+    case ALGO_FILTER_NE:      return _mm512_cmpneq_epi32_mask(x, va);
+    case ALGO_FILTER_LT:      return _mm512_cmplt_epi32_mask(x, va);
+    case ALGO_FILTER_LE:      return _mm512_cmple_epi32_mask(x, va);
+    case ALGO_FILTER_GT:      return _mm512_cmpgt_epi32_mask(x, va);
+    case ALGO_FILTER_GE:      return _mm512_cmpge_epi32_mask(x, va);
+    case ALGO_FILTER_BETWEEN: return _mm512_mask_cmple_epi32_mask(_mm512_cmpge_epi32_mask(x, va), x, vb);
+    case ALGO_FILTER_MASK_EQ: return _mm512_cmpeq_epi32_mask(_mm512_and_si512(x, va), vb);
+    }
+    return 0;
+}
+
+CANON_C_TARGET("avx512f")
+static inline __mmask8 algo_filter_cmp_i64_avx512_(__m512i x, AlgoFilterOp op, __m512i va, __m512i vb)
+{
+    switch (op) {
+    case ALGO_FILTER_EQ:      return _mm512_cmpeq_epi64_mask(x, va);
+    case ALGO_FILTER_NE:      return _mm512_cmpneq_epi64_mask(x, va);
+    case ALGO_FILTER_LT:      return _mm512_cmplt_epi64_mask(x, va);
+    case ALGO_FILTER_LE:      return _mm512_cmple_epi64_mask(x, va);
+    case ALGO_FILTER_GT:      return _mm512_cmpgt_epi64_mask(x, va);
+    case ALGO_FILTER_GE:      return _mm512_cmpge_epi64_mask(x, va);
+    case ALGO_FILTER_BETWEEN: return _mm512_mask_cmple_epi64_mask(_mm512_cmpge_epi64_mask(x, va), x, vb);
+    case ALGO_FILTER_MASK_EQ: return _mm512_cmpeq_epi64_mask(_mm512_and_si512(x, va), vb);
+    }
+    return 0;
+}
+
+CANON_C_TARGET("avx512f")
+static inline __mmask16 algo_filter_cmp_f32_avx512_(__m512 x, AlgoFilterOp op, __m512 va, __m512 vb)
+{
+    switch (op) {
+    case ALGO_FILTER_EQ:      return _mm512_cmp_ps_mask(x, va, _CMP_EQ_OQ);
+    case ALGO_FILTER_NE:      return _mm512_cmp_ps_mask(x, va, _CMP_NEQ_UQ);
+    case ALGO_FILTER_LT:      return _mm512_cmp_ps_mask(x, va, _CMP_LT_OQ);
+    case ALGO_FILTER_LE:      return _mm512_cmp_ps_mask(x, va, _CMP_LE_OQ);
+    case ALGO_FILTER_GT:      return _mm512_cmp_ps_mask(x, va, _CMP_GT_OQ);
+    case ALGO_FILTER_GE:      return _mm512_cmp_ps_mask(x, va, _CMP_GE_OQ);
+    case ALGO_FILTER_BETWEEN: return _mm512_mask_cmp_ps_mask(_mm512_cmp_ps_mask(x, va, _CMP_GE_OQ),
+                                                             x, vb, _CMP_LE_OQ);
+    default:                  break;
+    }
+    return 0;
+}
+
+CANON_C_TARGET("avx512f")
+static inline __mmask8 algo_filter_cmp_f64_avx512_(__m512d x, AlgoFilterOp op, __m512d va, __m512d vb)
+{
+    switch (op) {
+    case ALGO_FILTER_EQ:      return _mm512_cmp_pd_mask(x, va, _CMP_EQ_OQ);
+    case ALGO_FILTER_NE:      return _mm512_cmp_pd_mask(x, va, _CMP_NEQ_UQ);
+    case ALGO_FILTER_LT:      return _mm512_cmp_pd_mask(x, va, _CMP_LT_OQ);
+    case ALGO_FILTER_LE:      return _mm512_cmp_pd_mask(x, va, _CMP_LE_OQ);
+    case ALGO_FILTER_GT:      return _mm512_cmp_pd_mask(x, va, _CMP_GT_OQ);
+    case ALGO_FILTER_GE:      return _mm512_cmp_pd_mask(x, va, _CMP_GE_OQ);
+    case ALGO_FILTER_BETWEEN: return _mm512_mask_cmp_pd_mask(_mm512_cmp_pd_mask(x, va, _CMP_GE_OQ),
+                                                             x, vb, _CMP_LE_OQ);
+    default:                  break;
+    }
+    return 0;
+}
+
+/* ---------- AVX-512 kernels ---------- */
+
+CANON_C_TARGET("avx512f")
+static inline size_t algo_filter_i32_avx512_(const int32_t* in, size_t len, AlgoFilterOp op,
+                                             int32_t a, int32_t b, int32_t* out, size_t out_cap, size_t* n)
+{
+    __m512i va = _mm512_set1_epi32(a), vb = _mm512_set1_epi32(b);
+    size_t i = 0, k = *n;
+    for (; i + 16 <= len && k + 16 <= out_cap; i += 16) {
+        __m512i x = _mm512_loadu_si512((const void*)(in + i));
+        __mmask16 m = algo_filter_cmp_i32_avx512_(x, op, va, vb);
+        _mm512_mask_compressstoreu_epi32((void*)(out + k), m, x);
+        k += (size_t)__builtin_popcount(m);
+    }
+    *n = k;
+    return i;
+}
+
+CANON_C_TARGET("avx512f")
+static inline size_t algo_filter_i64_avx512_(const int64_t* in, size_t len, AlgoFilterOp op,
+                                             int64_t a, int64_t b, int64_t* out, size_t out_cap, size_t* n)
+{
+    __m512i va = _mm512_set1_epi64(a), vb = _mm512_set1_epi64(b);
+    size_t i = 0, k = *n;
+    for (; i + 8 <= len && k + 8 <= out_cap; i += 8) {
+        __m512i x = _mm512_loadu_si512((const void*)(in + i));
+        __mmask8 m = algo_filter_cmp_i64_avx512_(x, op, va, vb);
+        _mm512_mask_compressstoreu_epi64((void*)(out + k), m, x);
+        k += (size_t)__builtin_popcount(m);
+    }
+    *n = k;
+    return i;
+}
+
+CANON_C_TARGET("avx512f")
+static inline size_t algo_filter_f32_avx512_(const float* in, size_t len, AlgoFilterOp op,
+                                             float a, float b, float* out, size_t out_cap, size_t* n)
+{
+    __m512 va = _mm512_set1_ps(a), vb = _mm512_set1_ps(b);
+    size_t i = 0, k = *n;
+    for (; i + 16 <= len && k + 16 <= out_cap; i += 16) {
+        __m512 x = _mm512_loadu_ps(in + i);
+        __mmask16 m = algo_filter_cmp_f32_avx512_(x, op, va, vb);
+        _mm512_mask_compressstoreu_ps((void*)(out + k), m, x);
+        k += (size_t)__builtin_popcount(m);
+    }
+    *n = k;
+    return i;
+}
+
+CANON_C_TARGET("avx512f")
+static inline size_t algo_filter_f64_avx512_(const double* in, size_t len, AlgoFilterOp op,
+                                             double a, double b, double* out, size_t out_cap, size_t* n)
+{
+    __m512d va = _mm512_set1_pd(a), vb = _mm512_set1_pd(b);
+    size_t i = 0, k = *n;
+    for (; i + 8 <= len && k + 8 <= out_cap; i += 8) {
+        __m512d x = _mm512_loadu_pd(in + i);
+        __mmask8 m = algo_filter_cmp_f64_avx512_(x, op, va, vb);
+        _mm512_mask_compressstoreu_pd((void*)(out + k), m, x);
+        k += (size_t)__builtin_popcount(m);
+    }
+    *n = k;
+    return i;
+}
+
+#endif /* CANON_C_X86_SIMD */
+
+/* ============================================================
+   Public filters
+   ============================================================ */
+
+#if CANON_C_X86_SIMD
+#define ALGO_FILTER_SIMD_(name) \
+    { \
+        CpuFeatures cpu = cpu_features(); \
+        if (cpu.avx512f)   i = algo_filter_##name##_avx512_(in, len, op, a, b, out, out_cap, &n); \
+        else if (cpu.avx2) i = algo_filter_##name##_avx2_(in, len, op, a, b, out, out_cap, &n); \
+    }
+#else
+#define ALGO_FILTER_SIMD_(name)
+#endif
+
+/* Vector kernels first, then the branchless scalar loop for the rest */
+#define ALGO_FILTER_DEFINE_(name, T, is_integer) \
+static inline size_t algo_filter_##name( \
+    const T* in, size_t len, AlgoFilterOp op, T a, T b, T* out, size_t out_cap) \
+{ \
+    if (!in || !out || !algo_filter_op_valid_(op, is_integer)) return 0; \
+    size_t i = 0, n = 0; \
+    ALGO_FILTER_SIMD_(name) \
+    for (; i < len && n < out_cap; ++i) { \
+        T x = in[i]; \
+        out[n] = x; \
+        n += algo_filter_match_##name##_(x, op, a, b); \
+    } \
+    return n; \
+}
+
+ALGO_FILTER_DEFINE_(i32, int32_t, true)
+ALGO_FILTER_DEFINE_(i64, int64_t, true)
+ALGO_FILTER_DEFINE_(f32, float,   false)
+ALGO_FILTER_DEFINE_(f64, double,  false)
+
+#endif /* CANON_C_ALGO_FILTER_SIMD_H */
@@ -18,6 +18,9 @@
       - Short-circuiting
       - No allocation, mutation, or ownership
       - Optional user context
+
+    For plain integer arrays searched by value or range, find_simd.h
+    compares a whole vector per step instead of calling a predicate.
 */
 
 typedef bool (*algo_find_pred)(const void* elem, void* ctx);
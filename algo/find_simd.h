@@ -0,0 +1,311 @@
+#ifndef CANON_C_ALGO_FIND_SIMD_H
+#define CANON_C_ALGO_FIND_SIMD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "core/cpu.h"
+
+/*
+    find_simd.h — Vectorized find / count for 8/16/32/64-bit elements
+
+    memchr-style scans for plain integer arrays, where algo_find /
+    ALGO_FIND would call a predicate for every element:
+
+      algo_find_eq_##S(array, len, value, out_index)       first x == value
+      algo_find_range_##S(array, len, lo, hi, out_index)   first lo <= x <= hi
+      algo_count_eq_##S(array, len, value)                 number of x == value
+
+    S is u8, u16, u32, u64 or i8, i16, i32, i64 (equality is bitwise, so
+    the signed versions only differ from the unsigned ones for ranges).
+
+    Find functions follow the ALGO_FIND contract: they return true on a
+    match and write the index to out_index (optional, may be NULL);
+    false on no match, invalid input, or an empty range (lo > hi).
+    count_eq returns 0 on invalid input.
+
+    Every vector compare covers 16 (SSE2) or 32 (AVX2) bytes and turns
+    into a byte mask with movemask; the first set bit locates the match.
+    The scan starts with one unaligned vector, continues on aligned
+    vectors from the next vector boundary (four per step, tested
+    together), and finishes with one unaligned vector ending at the last
+    element. Head and tail overlap the aligned body instead of reading
+    past either end of the array. Arrays shorter than one vector are
+    scanned with scalar code.
+
+    The best ISA is chosen at run time (cpu.h); 64-bit ranges need
+    AVX2 (SSE2 has no 64-bit compare) and otherwise run scalar.
+*/
+
+/* Top bit of a W-bit lane */
+#define ALGO_FIND_SIGN_(W) ((uint64_t)1 << ((W) - 1))
+
+/* ============================================================
+   Vector kernels (internal, x86 only)
+   ============================================================ */
+
+#if CANON_C_X86_SIMD
+
+CANON_C_TARGET("sse2") static inline __m128i algo_find_load_sse2_(const void* p) { return _mm_loadu_si128((const __m128i*)p); }
+CANON_C_TARGET("avx2") static inline __m256i algo_find_load_avx2_(const void* p) { return _mm256_loadu_si256((const __m256i*)p); }
+
+CANON_C_TARGET("sse2") static inline __m128i algo_find_set1_8_sse2_(uint64_t v)  { return _mm_set1_epi8((char)v); }
+CANON_C_TARGET("sse2") static inline __m128i algo_find_set1_16_sse2_(uint64_t v) { return _mm_set1_epi16((short)v); }
+CANON_C_TARGET("sse2") static inline __m128i algo_find_set1_32_sse2_(uint64_t v) { return _mm_set1_epi32((int)v); }
+CANON_C_TARGET("sse2") static inline __m128i algo_find_set1_64_sse2_(uint64_t v) { return _mm_set1_epi64x((long long)v); }
+CANON_C_TARGET("avx2") static inline __m256i algo_find_set1_8_avx2_(uint64_t v)  { return _mm256_set1_epi8((char)v); }
+CANON_C_TARGET("avx2") static inline __m256i algo_find_set1_16_avx2_(uint64_t v) { return _mm256_set1_epi16((short)v); }
+CANON_C_TARGET("avx2") static inline __m256i algo_find_set1_32_avx2_(uint64_t v) { return _mm256_set1_epi32((int)v); }
+CANON_C_TARGET("avx2") static inline __m256i algo_find_set1_64_avx2_(uint64_t v) { return _mm256_set1_epi64x((long long)v); }
+
+/* SSE2 has no 64-bit equality: both 32-bit halves must match */
+CANON_C_TARGET("sse2")
+static inline __m128i algo_find_cmpeq64_sse2_(__m128i a, __m128i b)
+{
+    __m128i c = _mm_cmpeq_epi32(a, b);
+    return _mm_and_si128(c, _mm_shuffle_epi32(c, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+/*
+   Ranges compare (x - lo) with (hi - lo) as unsigned numbers; SIMD only
+   has signed compares, so both sides get their sign bit flipped.
+
+   Byte masks: bit j set when byte j of the vector at p belongs to a
+   matching element (a matching W-bit lane sets W/8 consecutive bits).
+   v0 / v1 are the broadcast operands prepared by the driver.
+*/
+#define ALGO_FIND_EQ_MASK_(isa, W, VT, CMPEQ, MOVEMASK) \
+CANON_C_TARGET(#isa) \
+static inline uint32_t algo_find_eq##W##_mask_##isa##_(const void* p, VT v0, VT v1) \
+{ \
+    (void)v1; \
+    return (uint32_t)MOVEMASK(CMPEQ(algo_find_load_##isa##_(p), v0)); \
+}
+
+#define ALGO_FIND_RANGE_MASK_(isa, W, VT, SUB, XOR, CMPGT, MOVEMASK, FULL) \
+CANON_C_TARGET(#isa) \
+static inline uint32_t algo_find_range##W##_mask_##isa##_(const void* p, VT v0, VT v1) \
+{ \
+    VT t = XOR(SUB(algo_find_load_##isa##_(p), v0), algo_find_set1_##W##_##isa##_(ALGO_FIND_SIGN_(W))); \
+    return ~(uint32_t)MOVEMASK(CMPGT(t, v1)) & (FULL); \
+}
+
+ALGO_FIND_EQ_MASK_(sse2, 8,  __m128i, _mm_cmpeq_epi8,  _mm_movemask_epi8)
+ALGO_FIND_EQ_MASK_(sse2, 16, __m128i, _mm_cmpeq_epi16, _mm_movemask_epi8)
+ALGO_FIND_EQ_MASK_(sse2, 32, __m128i, _mm_cmpeq_epi32, _mm_movemask_epi8)
+ALGO_FIND_EQ_MASK_(sse2, 64, __m128i, algo_find_cmpeq64_sse2_, _mm_movemask_epi8)
+ALGO_FIND_RANGE_MASK_(sse2, 8,  __m128i, _mm_sub_epi8,  _mm_xor_si128, _mm_cmpgt_epi8,  _mm_movemask_epi8, 0xFFFFu)
+ALGO_FIND_RANGE_MASK_(sse2, 16, __m128i, _mm_sub_epi16, _mm_xor_si128, _mm_cmpgt_epi16, _mm_movemask_epi8, 0xFFFFu)
+ALGO_FIND_RANGE_MASK_(sse2, 32, __m128i, _mm_sub_epi32, _mm_xor_si128, _mm_cmpgt_epi32, _mm_movemask_epi8, 0xFFFFu)
+
+ALGO_FIND_EQ_MASK_(avx2, 8,  __m256i, _mm256_cmpeq_epi8,  _mm256_movemask_epi8)
+ALGO_FIND_EQ_MASK_(avx2, 16, __m256i, _mm256_cmpeq_epi16, _mm256_movemask_epi8)
+ALGO_FIND_EQ_MASK_(avx2, 32, __m256i, _mm256_cmpeq_epi32, _mm256_movemask_epi8)
+ALGO_FIND_EQ_MASK_(avx2, 64, __m256i, _mm256_cmpeq_epi64, _mm256_movemask_epi8)
+ALGO_FIND_RANGE_MASK_(avx2, 8,  __m256i, _mm256_sub_epi8,  _mm256_xor_si256, _mm256_cmpgt_epi8,  _mm256_movemask_epi8, 0xFFFFFFFFu)
+ALGO_FIND_RANGE_MASK_(avx2, 16, __m256i, _mm256_sub_epi16, _mm256_xor_si256, _mm256_cmpgt_epi16, _mm256_movemask_epi8, 0xFFFFFFFFu)
+ALGO_FIND_RANGE_MASK_(avx2, 32, __m256i, _mm256_sub_epi32, _mm256_xor_si256, _mm256_cmpgt_epi32, _mm256_movemask_epi8, 0xFFFFFFFFu)
+ALGO_FIND_RANGE_MASK_(avx2, 64, __m256i, _mm256_sub_epi64, _mm256_xor_si256, _mm256_cmpgt_epi64, _mm256_movemask_epi8, 0xFFFFFFFFu)
+
+/*
+   Drivers over a byte mask. Both require len * (W / 8) >= VBYTES, so
+   the unaligned head and tail vectors lie inside the array.
+     _first_: index of the first matching element, or SIZE_MAX
+     _count_: number of matching elements (head and tail bits that
+              overlap the aligned body are dropped before counting)
+*/
+#define ALGO_FIND_DRIVERS_(isa, kind, W, VT, VBYTES) \
+CANON_C_TARGET(#isa) \
+static inline size_t algo_find_##kind##W##_first_##isa##_(const void* array, size_t len, uint64_t x0, uint64_t x1) \
+{ \
+    VT v0 = algo_find_set1_##W##_##isa##_(x0), v1 = algo_find_set1_##W##_##isa##_(x1); \
+    const char* a = (const char*)array; \
+    const char* end = a + len * (W / 8); \
+    uint32_t m = algo_find_##kind##W##_mask_##isa##_(a, v0, v1); \
+    if (m) return (size_t)__builtin_ctz(m) / (W / 8); \
+    const char* p = (const char*)(((uintptr_t)a + (VBYTES)) & ~(uintptr_t)((VBYTES) - 1)); \
+    for (; end - p >= 4 * (VBYTES); p += 4 * (VBYTES)) { \
+        uint32_t m0 = algo_find_##kind##W##_mask_##isa##_(p, v0, v1); \
+        uint32_t m1 = algo_find_##kind##W##_mask_##isa##_(p + (VBYTES), v0, v1); \
+        uint32_t m2 = algo_find_##kind##W##_mask_##isa##_(p + 2 * (VBYTES), v0, v1); \
+        uint32_t m3 = algo_find_##kind##W##_mask_##isa##_(p + 3 * (VBYTES), v0, v1); \
+        if (m0 | m1 | m2 | m3) { \
+            if (!m0) { p += (VBYTES); m0 = m1; } \
+            if (!m0) { p += (VBYTES); m0 = m2; } \
+            if (!m0) { p += (VBYTES); m0 = m3; } \
+            return ((size_t)(p - a) + (size_t)__builtin_ctz(m0)) / (W / 8); \
+        } \
+    } \
+    for (; end - p >= (VBYTES); p += (VBYTES)) { \
+        m = algo_find_##kind##W##_mask_##isa##_(p, v0, v1); \
+        if (m) return ((size_t)(p - a) + (size_t)__builtin_ctz(m)) / (W / 8); \
+    } \
+    if (p < end) { \
+        p = end - (VBYTES); \
+        m = algo_find_##kind##W##_mask_##isa##_(p, v0, v1); \
+        if (m) return ((size_t)(p - a) + (size_t)__builtin_ctz(m)) / (W / 8); \
+    } \
+    return SIZE_MAX; \
+} \
+\
+CANON_C_TARGET(#isa) \
+static inline size_t algo_find_##kind##W##_count_##isa##_(const void* array, size_t len, uint64_t x0, uint64_t x1) \
+{ \
+    VT v0 = algo_find_set1_##W##_##isa##_(x0), v1 = algo_find_set1_##W##_##isa##_(x1); \
+    const char* a = (const char*)array; \
+    const char* end = a + len * (W / 8); \
+    const char* p = (const char*)(((uintptr_t)a + (VBYTES)) & ~(uintptr_t)((VBYTES) - 1)); \
+    uint64_t head = ((uint64_t)1 << (p - a)) - 1; \
+    size_t bits = (size_t)__builtin_popcountll(algo_find_##kind##W##_mask_##isa##_(a, v0, v1) & head); \
+    for (; end - p >= (VBYTES); p += (VBYTES)) { \
+        bits += (size_t)__builtin_popcount(algo_find_##kind##W##_mask_##isa##_(p, v0, v1)); \
+    } \
+    if (p < end) { \
+        size_t seen = (size_t)(p - (end - (VBYTES))); \
+        bits += (size_t)__builtin_popcount(algo_find_##kind##W##_mask_##isa##_(end - (VBYTES), v0, v1) >> seen); \
+    } \
+    return bits / (W / 8); \
+}
+
+ALGO_FIND_DRIVERS_(sse2, eq, 8,  __m128i, 16)
+ALGO_FIND_DRIVERS_(sse2, eq, 16, __m128i, 16)
+ALGO_FIND_DRIVERS_(sse2, eq, 32, __m128i, 16)
+ALGO_FIND_DRIVERS_(sse2, eq, 64, __m128i, 16)
+ALGO_FIND_DRIVERS_(sse2, range, 8,  __m128i, 16)
+ALGO_FIND_DRIVERS_(sse2, range, 16, __m128i, 16)
+ALGO_FIND_DRIVERS_(sse2, range, 32, __m128i, 16)
+
+ALGO_FIND_DRIVERS_(avx2, eq, 8,  __m256i, 32)
+ALGO_FIND_DRIVERS_(avx2, eq, 16, __m256i, 32)
+ALGO_FIND_DRIVERS_(avx2, eq, 32, __m256i, 32)
+ALGO_FIND_DRIVERS_(avx2, eq, 64, __m256i, 32)
+ALGO_FIND_DRIVERS_(avx2, range, 8,  __m256i, 32)
+ALGO_FIND_DRIVERS_(avx2, range, 16, __m256i, 32)
+ALGO_FIND_DRIVERS_(avx2, range, 32, __m256i, 32)
+ALGO_FIND_DRIVERS_(avx2, range, 64, __m256i, 32)
+
+/* No SSE2 64-bit range kernel: report "not handled" so the caller stays scalar */
+#define ALGO_FIND_HAS_SSE2_eq8     1
+#define ALGO_FIND_HAS_SSE2_eq16    1
+#define ALGO_FIND_HAS_SSE2_eq32    1
+#define ALGO_FIND_HAS_SSE2_eq64    1
+#define ALGO_FIND_HAS_SSE2_range8  1
+#define ALGO_FIND_HAS_SSE2_range16 1
+#define ALGO_FIND_HAS_SSE2_range32 1
+#define ALGO_FIND_HAS_SSE2_range64 0
+
+static inline size_t algo_find_range64_first_sse2_(const void* a, size_t len, uint64_t x0, uint64_t x1)
+{
+    (void)a; (void)len; (void)x0; (void)x1;
+    return SIZE_MAX;
+}
+
+static inline size_t algo_find_range64_count_sse2_(const void* a, size_t len, uint64_t x0, uint64_t x1)
+{
+    (void)a; (void)len; (void)x0; (void)x1;
+    return 0;
+}
+
+/*
+   Picks the widest kernel that fits the array; sets *done when a vector
+   kernel ran (its result is in the return value).
+*/
+#define ALGO_FIND_DISPATCH_(kind, W, op, a, len, x0, x1, done) \
+    ({ \
+        size_t r_ = 0; \
+        CpuFeatures f_ = cpu_features(); \
+        size_t bytes_ = (len) * (W / 8); \
+        if (f_.avx2 && bytes_ >= 32) { \
+            r_ = algo_find_##kind##W##_##op##_avx2_((a), (len), (x0), (x1)); \
+            *(done) = true; \
+        } else if (ALGO_FIND_HAS_SSE2_##kind##W && f_.sse2 && bytes_ >= 16) { \
+            r_ = algo_find_##kind##W##_##op##_sse2_((a), (len), (x0), (x1)); \
+            *(done) = true; \
+        } \
+        r_; \
+    })
+
+#else
+
+#define ALGO_FIND_DISPATCH_(kind, W, op, a, len, x0, x1, done) ((void)(done), (size_t)0)
+
+#endif /* CANON_C_X86_SIMD */
+
+/* ============================================================
+   Public functions
+   ============================================================ */
+
+#define ALGO_FIND_DEFINE_(W, UT, IT) \
+static inline bool algo_find_eq_u##W(const UT* array, size_t len, UT value, size_t* out_index) \
+{ \
+    if (!array) return false; \
+    bool done = false; \
+    size_t idx = ALGO_FIND_DISPATCH_(eq, W, first, array, len, value, 0, &done); \
+    if (!done) { \
+        idx = SIZE_MAX; \
+        for (size_t i = 0; i < len; ++i) { \
+            if (array[i] == value) { idx = i; break; } \
+        } \
+    } \
+    if (idx == SIZE_MAX) return false; \
+    if (out_index) *out_index = idx; \
+    return true; \
+} \
+\
+static inline size_t algo_count_eq_u##W(const UT* array, size_t len, UT value) \
+{ \
+    if (!array) return 0; \
+    bool done = false; \
+    size_t count = ALGO_FIND_DISPATCH_(eq, W, count, array, len, value, 0, &done); \
+    if (!done) { \
+        for (size_t i = 0; i < len; ++i) count += array[i] == value; \
+    } \
+    return count; \
+} \
+\
+/* (UT)(x - lo) <= (UT)(hi - lo) tests both ends of [lo, hi] at once */ \
+static inline bool algo_find_range_u##W##_(const UT* array, size_t len, UT lo, UT hi, size_t* out_index) \
+{ \
+    UT span = (UT)(hi - lo); \
+    bool done = false; \
+    size_t idx = ALGO_FIND_DISPATCH_(range, W, first, array, len, lo, \
+                                     (UT)(span ^ (UT)ALGO_FIND_SIGN_(W)), &done); \
+    if (!done) { \
+        idx = SIZE_MAX; \
+        for (size_t i = 0; i < len; ++i) { \
+            if ((UT)(array[i] - lo) <= span) { idx = i; break; } \
+        } \
+    } \
+    if (idx == SIZE_MAX) return false; \
+    if (out_index) *out_index = idx; \
+    return true; \
+} \
+\
+static inline bool algo_find_range_u##W(const UT* array, size_t len, UT lo, UT hi, size_t* out_index) \
+{ \
+    if (!array || lo > hi) return false; \
+    return algo_find_range_u##W##_(array, len, lo, hi, out_index); \
+} \
+\
+static inline bool algo_find_eq_i##W(const IT* array, size_t len, IT value, size_t* out_index) \
+{ \
+    return algo_find_eq_u##W((const UT*)array, len, (UT)value, out_index); \
+} \
+\
+static inline size_t algo_count_eq_i##W(const IT* array, size_t len, IT value) \
+{ \
+    return algo_count_eq_u##W((const UT*)array, len, (UT)value); \
+} \
+\
+static inline bool algo_find_range_i##W(const IT* array, size_t len, IT lo, IT hi, size_t* out_index) \
+{ \
+    if (!array || lo > hi) return false; \
+    return algo_find_range_u##W##_((const UT*)array, len, (UT)lo, (UT)hi, out_index); \
+}
+
+ALGO_FIND_DEFINE_(8,  uint8_t,  int8_t)
+ALGO_FIND_DEFINE_(16, uint16_t, int16_t)
+ALGO_FIND_DEFINE_(32, uint32_t, int32_t)
+ALGO_FIND_DEFINE_(64, uint64_t, int64_t)
+
+#endif /* CANON_C_ALGO_FIND_SIMD_H */
@@ -0,0 +1,348 @@
+#ifndef CANON_C_ALGO_PARALLEL_H
+#define CANON_C_ALGO_PARALLEL_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "core/arena.h"
+
+/*
+    parallel.h — Caller-provided workers; parallel map / fold / any / all
+
+    Canon-C never creates threads. Parallel algorithms receive an
+    AlgoWorkers value that describes how the caller runs tasks
+    (thread pool, OpenMP, job system, ...).
+
+    Contract for run(impl, task, ctx, count):
+      - calls task(ctx, i) exactly once for every i in [0, count)
+      - calls may run concurrently, in any order
+      - returns only after every call has finished
+        (this is the only synchronization the algorithms rely on)
+
+    A NULL AlgoWorkers (or a NULL run) means "run on the calling thread".
+
+    Example with a hypothetical pool:
+        static void run_on_pool(void* pool, algo_task_fn task, void* ctx, size_t n)
+        {
+            my_pool_parallel_for((MyPool*)pool, n, task, ctx);  // blocks until done
+        }
+        AlgoWorkers w = { .run = run_on_pool, .impl = &pool, .workers = 8 };
+
+    Parallel map / fold / any / all (contiguous arrays):
+      The input is cut into chunks of about ALGO_PARALLEL_CHUNK_BYTES,
+      one task per chunk, so each task streams a cache-sized block and
+      a pool with work-stealing balances uneven costs. The chunking
+      depends only on len and element size, never on the worker count,
+      so results are reproducible across machines.
+*/
+
+typedef void (*algo_task_fn)(void* ctx, size_t index);
+
+typedef struct {
+    void (*run)(void* impl, algo_task_fn task, void* ctx, size_t count);
+    void* impl;      /* caller's executor state */
+    size_t workers;  /* tasks that can make progress at once (>= 1) */
+} AlgoWorkers;
+
+/* Number of concurrent workers (1 for NULL / serial) */
+static inline size_t algo_workers_count(const AlgoWorkers* w)
+{
+    return (w && w->run && w->workers > 0) ? w->workers : 1;
+}
+
+/* Run task(ctx, i) for i in [0, count) and wait for all of them */
+static inline void algo_workers_run(const AlgoWorkers* w, algo_task_fn task, void* ctx, size_t count)
+{
+    if (!task || count == 0) return;
+    if (!w || !w->run || count == 1) {
+        for (size_t i = 0; i < count; ++i) task(ctx, i);
+        return;
+    }
+    w->run(w->impl, task, ctx, count);
+}
+
+/*
+   algo_split(len, parts, i):
+   Start of part i when [0, len) is cut into `parts` near-equal
+   contiguous pieces (i == parts yields len). Overflow-free.
+*/
+static inline size_t algo_split(size_t len, size_t parts, size_t i)
+{
+    size_t q = len / parts, r = len % parts;
+    return i * q + (i < r ? i : r);
+}
+
+/* ============================================================
+   Chunking
+   ============================================================ */
+
+/* Input bytes per task */
+#define ALGO_PARALLEL_CHUNK_BYTES ((size_t)64 * 1024)
+
+/* any / all check for cancellation this often inside a chunk */
+#define ALGO_PARALLEL_CANCEL_STRIDE 256
+
+static inline size_t algo_parallel_chunk_len_(size_t elem_size)
+{
+    return elem_size < ALGO_PARALLEL_CHUNK_BYTES ? ALGO_PARALLEL_CHUNK_BYTES / elem_size : 1;
+}
+
+static inline size_t algo_parallel_chunks_(size_t len, size_t chunk_len)
+{
+    return len / chunk_len + (len % chunk_len != 0);
+}
+
+/* ============================================================
+   Parallel map
+   ============================================================ */
+
+typedef void (*algo_map_ctx_fn)(void* out, const void* in, void* ctx);
+
+typedef struct {
+    const char* in;
+    char* out;
+    size_t in_size;
+    size_t out_size;
+    size_t len;
+    size_t chunk_len;
+    algo_map_ctx_fn f;
+    void* ctx;
+} AlgoMapParallel_;
+
+static inline void algo_map_parallel_task_(void* arg, size_t c)
+{
+    const AlgoMapParallel_* m = (const AlgoMapParallel_*)arg;
+    size_t lo = c * m->chunk_len;
+    size_t hi = m->len - lo > m->chunk_len ? lo + m->chunk_len : m->len;
+    for (size_t i = lo; i < hi; ++i) {
+        m->f(m->out + i * m->out_size, m->in + i * m->in_size, m->ctx);
+    }
+}
+
+/*
+   algo_map_parallel:
+     f(&out[i], &in[i], ctx) for every i in [0, len), spread over workers.
+     f must only write its own output element (no shared state without
+     its own synchronization). Does nothing on invalid input.
+*/
+static inline void algo_map_parallel(
+    const void* in,
+    size_t in_size,
+    void* out,
+    size_t out_size,
+    size_t len,
+    algo_map_ctx_fn f,
+    void* ctx,
+    const AlgoWorkers* workers  // optional
+)
+{
+    if (!in || !out || !f || in_size == 0 || out_size == 0 || len == 0) return;
+    size_t size = in_size > out_size ? in_size : out_size;
+    AlgoMapParallel_ m = {
+        .in = (const char*)in, .out = (char*)out, .in_size = in_size, .out_size = out_size,
+        .len = len, .chunk_len = algo_parallel_chunk_len_(size), .f = f, .ctx = ctx,
+    };
+    algo_workers_run(workers, algo_map_parallel_task_, &m, algo_parallel_chunks_(len, m.chunk_len));
+}
+
+/*
+    ALGO_MAP_PARALLEL_TYPED(out_array, in_array, len, OutType, InType, fn, ctx, workers)
+      fn signature: void fn(OutType* out, const InType* in, void* ctx)
+*/
+#define ALGO_MAP_PARALLEL_TYPED(out_array, in_array, len, OutType, InType, fn, ctx, workers) \
+    algo_map_parallel((in_array), sizeof(InType), (out_array), sizeof(OutType), (len), \
+                      (algo_map_ctx_fn)(fn), (ctx), (workers))
+
+/* ============================================================
+   Parallel fold
+   ============================================================ */
+
+typedef void (*algo_fold_fn)(void* acc, const void* item, void* ctx);
+
+/* Merge accumulator `from` into `acc`; must be associative */
+typedef void (*algo_combine_fn)(void* acc, const void* from, void* ctx);
+
+typedef struct {
+    const char* items;
+    size_t elem_size;
+    size_t len;
+    size_t chunk_len;
+    char* partials;
+    size_t acc_size;
+    const void* identity;
+    algo_fold_fn f;
+    void* ctx;
+} AlgoFoldParallel_;
+
+static inline void algo_fold_parallel_task_(void* arg, size_t c)
+{
+    const AlgoFoldParallel_* p = (const AlgoFoldParallel_*)arg;
+    void* acc = p->partials + c * p->acc_size;
+    memcpy(acc, p->identity, p->acc_size);
+    size_t lo = c * p->chunk_len;
+    size_t hi = p->len - lo > p->chunk_len ? lo + p->chunk_len : p->len;
+    for (size_t i = lo; i < hi; ++i) {
+        p->f(acc, p->items + i * p->elem_size, p->ctx);
+    }
+}
+
+/*
+   algo_fold_parallel:
+     Folds items into acc in parallel: every chunk is folded into its
+     own partial accumulator, starting from a copy of `identity`, and
+     the partials are then combined into acc in chunk order.
+       f:        fold one item into an accumulator (as algo_fold)
+       combine:  associative merge of two accumulators, with `identity`
+                 as its neutral element
+       acc_size: bytes of one accumulator (partials are memcpy'd)
+       scratch:  Arena for one accumulator per chunk, rolled back
+                 before returning (not needed for a single chunk)
+     Equals the sequential fold for associative combine; with floating
+     point the grouping differs from it but is the same on every run.
+     Returns false (acc untouched) on invalid input or missing scratch.
+*/
+static inline bool algo_fold_parallel(
+    void* acc,
+    size_t acc_size,
+    const void* identity,
+    const void* items,
+    size_t len,
+    size_t elem_size,
+    algo_fold_fn f,
+    algo_combine_fn combine,
+    void* ctx,
+    Arena* scratch,
+    const AlgoWorkers* workers  // optional
+)
+{
+    if (!acc || !identity || !items || !f || !combine || acc_size == 0 || elem_size == 0) return false;
+    size_t chunk_len = algo_parallel_chunk_len_(elem_size);
+    size_t chunks = algo_parallel_chunks_(len, chunk_len);
+    if (chunks <= 1) {
+        for (size_t i = 0; i < len; ++i) f(acc, (const char*)items + i * elem_size, ctx);
+        return true;
+    }
+    if (!scratch || chunks > SIZE_MAX / acc_size) return false;
+
+    ArenaMark mark = arena_mark(scratch);
+    char* partials = (char*)arena_alloc(scratch, chunks * acc_size);
+    if (!partials) return false;
+
+    AlgoFoldParallel_ p = {
+        .items = (const char*)items, .elem_size = elem_size, .len = len, .chunk_len = chunk_len,
+        .partials = partials, .acc_size = acc_size, .identity = identity, .f = f, .ctx = ctx,
+    };
+    algo_workers_run(workers, algo_fold_parallel_task_, &p, chunks);
+    for (size_t c = 0; c < chunks; ++c) combine(acc, partials + c * acc_size, ctx);
+
+    arena_reset_to(scratch, mark);
+    return true;
+}
+
+/*
+    ALGO_FOLD_PARALLEL(acc_ptr, identity_ptr, array, len, Type, fold_fn, combine_fn, ctx, scratch, workers)
+      fold_fn:    void fold_fn(AccType* acc, const Type* item, void* ctx)
+      combine_fn: void combine_fn(AccType* acc, const AccType* from, void* ctx)
+*/
+#define ALGO_FOLD_PARALLEL(acc_ptr, identity_ptr, array, len, Type, fold_fn, combine_fn, ctx, scratch, workers) \
+    algo_fold_parallel((acc_ptr), sizeof(*(acc_ptr)), (identity_ptr), (array), (len), sizeof(Type), \
+                       (algo_fold_fn)(fold_fn), (algo_combine_fn)(combine_fn), (ctx), (scratch), (workers))
+
+/* ============================================================
+   Parallel any / all
+   ============================================================ */
+
+typedef bool (*algo_pred_fn)(const void* elem, void* ctx);
+
+typedef struct {
+    const char* items;
+    size_t elem_size;
+    size_t len;
+    size_t chunk_len;
+    algo_pred_fn pred;
+    void* ctx;
+    bool target;         /* any: stop at pred == true; all: at pred == false */
+    atomic_bool found;   /* set once a stopping element is seen */
+} AlgoAnyParallel_;
+
+static inline void algo_any_parallel_task_(void* arg, size_t c)
+{
+    AlgoAnyParallel_* a = (AlgoAnyParallel_*)arg;
+    if (atomic_load_explicit(&a->found, memory_order_relaxed)) return;
+    size_t lo = c * a->chunk_len;
+    size_t hi = a->len - lo > a->chunk_len ? lo + a->chunk_len : a->len;
+    for (size_t i = lo; i < hi; ++i) {
+        if (a->pred(a->items + i * a->elem_size, a->ctx) == a->target) {
+            atomic_store_explicit(&a->found, true, memory_order_relaxed);
+            return;
+        }
+        /* Cooperative cancellation: another task already decided */
+        if ((i - lo) % ALGO_PARALLEL_CANCEL_STRIDE == ALGO_PARALLEL_CANCEL_STRIDE - 1
+            && atomic_load_explicit(&a->found, memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+static inline bool algo_any_parallel_(
+    const void* items, size_t len, size_t elem_size,
+    algo_pred_fn pred, void* ctx, bool target, const AlgoWorkers* workers)
+{
+    AlgoAnyParallel_ a = {
+        .items = (const char*)items, .elem_size = elem_size, .len = len,
+        .chunk_len = algo_parallel_chunk_len_(elem_size), .pred = pred, .ctx = ctx,
+        .target = target,
+    };
+    atomic_init(&a.found, false);
+    algo_workers_run(workers, algo_any_parallel_task_, &a, algo_parallel_chunks_(len, a.chunk_len));
+    return atomic_load_explicit(&a.found, memory_order_relaxed);
+}
+
+/*
+   algo_any_parallel:
+     True if pred holds for some element. Once one task finds a match,
+     the others stop at their next check; pred may still run on a few
+     elements after the match, in any order.
+     Returns false on invalid input or len == 0.
+*/
+static inline bool algo_any_parallel(
+    const void* items,
+    size_t len,
+    size_t elem_size,
+    algo_pred_fn pred,
+    void* ctx,
+    const AlgoWorkers* workers  // optional
+)
+{
+    if (!items || !pred || elem_size == 0) return false;
+    return algo_any_parallel_(items, len, elem_size, pred, ctx, true, workers);
+}
+
+/*
+   algo_all_parallel:
+     True if pred holds for every element; stops early like
+     algo_any_parallel once a failing element is found.
+     Returns false on invalid input (true for len == 0).
+*/
+static inline bool algo_all_parallel(
+    const void* items,
+    size_t len,
+    size_t elem_size,
+    algo_pred_fn pred,
+    void* ctx,
+    const AlgoWorkers* workers  // optional
+)
+{
+    if (!items || !pred || elem_size == 0) return false;
+    return !algo_any_parallel_(items, len, elem_size, pred, ctx, false, workers);
+}
+
+/* pred signature: bool pred(const Type* elem, void* ctx) */
+#define ALGO_ANY_PARALLEL_TYPED(items, len, Type, pred, ctx, workers) \
+    algo_any_parallel((items), (len), sizeof(Type), (algo_pred_fn)(pred), (ctx), (workers))
+
+#define ALGO_ALL_PARALLEL_TYPED(items, len, Type, pred, ctx, workers) \
+    algo_all_parallel((items), (len), sizeof(Type), (algo_pred_fn)(pred), (ctx), (workers))
+
+#endif /* CANON_C_ALGO_PARALLEL_H */
@@ -0,0 +1,261 @@
+#ifndef CANON_C_ALGO_PARTITION_H
+#define CANON_C_ALGO_PARTITION_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "core/arena.h"
+#include "sort.h"
+
+/*
+    partition.h — In-place partitioning and selection
+
+    algo_partition:        matching elements first, unstable, branchless
+    algo_stable_partition: matching elements first, both groups keep
+                           their relative order (Arena scratch, or an
+                           in-place rotation fallback)
+    algo_select:           nth_element — put the k-th smallest at index k
+
+    All work in place on the caller's array; nothing is copied to a
+    second output buffer. For in-place stable filtering (dropping the
+    non-matching elements) see algo_retain in filter.h.
+
+    DEFINE_PARTITION generates typed versions with the predicate
+    inlined; typed selection is sort_##Type##_select from DEFINE_SORT.
+*/
+
+typedef bool (*algo_filter_pred)(const void* elem, void* ctx);
+
+/* ============================================================
+   Unstable partition
+   ============================================================ */
+
+/*
+   algo_partition:
+     Reorders array so that every element satisfying pred comes first.
+     Returns the number of matching elements (the partition point).
+     Branchless: every step swaps a[w] and a[i] and advances w by the
+     predicate result. Elements in [w, i) never match, so a swap for a
+     non-matching a[i] only exchanges two non-matching elements.
+*/
+static inline size_t algo_partition(
+    void* array,
+    size_t len,
+    size_t elem_size,
+    algo_filter_pred pred,
+    void* ctx
+)
+{
+    if (!array || !pred || elem_size == 0) return 0;
+    char* base = (char*)array;
+    size_t w = 0;
+    for (size_t i = 0; i < len; ++i) {
+        char* elem = base + i * elem_size;
+        bool keep = pred(elem, ctx);
+        if (w != i) algo_sort_swap_(base + w * elem_size, elem, elem_size);
+        w += keep;
+    }
+    return w;
+}
+
+/* ============================================================
+   Stable partition
+   ============================================================ */
+
+/* In-place stable partition of [lo, hi) by divide and rotate; O(n log n) */
+static inline size_t algo_stable_partition_inplace_(
+    char* base, size_t lo, size_t hi, size_t size, algo_filter_pred pred, void* ctx)
+{
+    if (hi - lo == 1) return lo + pred(base + lo * size, ctx);
+    size_t mid = lo + (hi - lo) / 2;
+    size_t a = algo_stable_partition_inplace_(base, lo, mid, size, pred, ctx);
+    size_t b = algo_stable_partition_inplace_(base, mid, hi, size, pred, ctx);
+    /* [lo, a) match, [a, mid) don't, [mid, b) match, [b, hi) don't */
+    if (a < mid && mid < b) algo_sort_rotate_(base, a, mid, b, size);
+    return a + (b - mid);
+}
+
+/*
+   algo_stable_partition:
+     Like algo_partition, but both groups keep their original order.
+     scratch: optional Arena. With room for the non-matching elements
+       (at most len * elem_size bytes) the partition is one O(n) pass;
+       the arena is rolled back before returning.
+       NULL or too small → O(n log n) in-place rotations, no memory.
+     Returns the number of matching elements.
+*/
+static inline size_t algo_stable_partition(
+    void* array,
+    size_t len,
+    size_t elem_size,
+    algo_filter_pred pred,
+    void* ctx,
+    Arena* scratch
+)
+{
+    if (!array || !pred || elem_size == 0) return 0;
+    if (len == 0) return 0;
+    char* base = (char*)array;
+
+    char* temp = NULL;
+    ArenaMark mark = arena_mark(scratch);
+    if (scratch && len <= SIZE_MAX / elem_size) {
+        temp = (char*)arena_alloc(scratch, len * elem_size);
+    }
+    if (!temp) return algo_stable_partition_inplace_(base, 0, len, elem_size, pred, ctx);
+
+    size_t w = 0, t = 0;
+    for (size_t i = 0; i < len; ++i) {
+        const char* elem = base + i * elem_size;
+        if (pred(elem, ctx)) {
+            if (w != i) memcpy(base + w * elem_size, elem, elem_size);
+            ++w;
+        } else {
+            memcpy(temp + t * elem_size, elem, elem_size);
+            ++t;
+        }
+    }
+    if (t) memcpy(base + w * elem_size, temp, t * elem_size);
+    arena_reset_to(scratch, mark);
+    return w;
+}
+
+/* ============================================================
+   Selection
+   ============================================================ */
+
+/*
+   algo_select (nth_element):
+     Afterwards array[k] holds the element a full sort would put there;
+     nothing in [0, k) compares greater and nothing in (k, len) less.
+     Use for medians and top-k without sorting: the k smallest elements
+     end up (unordered) in [0, k).
+     Quickselect with median-of-3 pivots; expected O(n). After too many
+     unbalanced rounds it falls back to sorting the remaining range.
+     Does nothing if k >= len.
+*/
+static inline void algo_select(
+    void* array,
+    size_t len,
+    size_t elem_size,
+    size_t k,
+    algo_cmp_fn cmp,
+    void* ctx
+)
+{
+    if (!array || !cmp || elem_size == 0 || k >= len) return;
+    char* a = (char*)array;
+    size_t n = len;
+    unsigned depth = 0;
+    for (size_t m = len; m > 1; m >>= 1) depth += 2;
+
+#define ALGO_SELECT_AT_(i) (a + (i) * elem_size)
+#define ALGO_SELECT_LESS_(x, y) (cmp(ALGO_SELECT_AT_(x), ALGO_SELECT_AT_(y), ctx) < 0)
+    while (n > ALGO_SORT_RUN) {
+        if (depth == 0) {
+            algo_sort(a, n, elem_size, cmp, ctx, NULL);
+            return;
+        }
+        --depth;
+
+        /* Median of first, middle, last → a[0] */
+        size_t mid = n / 2;
+        if (ALGO_SELECT_LESS_(mid, 0)) algo_sort_swap_(ALGO_SELECT_AT_(mid), ALGO_SELECT_AT_(0), elem_size);
+        if (ALGO_SELECT_LESS_(n - 1, mid)) algo_sort_swap_(ALGO_SELECT_AT_(n - 1), ALGO_SELECT_AT_(mid), elem_size);
+        if (ALGO_SELECT_LESS_(mid, 0)) algo_sort_swap_(ALGO_SELECT_AT_(mid), ALGO_SELECT_AT_(0), elem_size);
+        algo_sort_swap_(ALGO_SELECT_AT_(0), ALGO_SELECT_AT_(mid), elem_size);
+
+        /* Hoare partition around a[0] (same scheme as DEFINE_SORT) */
+        size_t i = 1, j = n - 1;
+        while (i < n && ALGO_SELECT_LESS_(i, 0)) ++i;
+        while (ALGO_SELECT_LESS_(0, j)) --j;
+        while (i < j) {
+            algo_sort_swap_(ALGO_SELECT_AT_(i), ALGO_SELECT_AT_(j), elem_size);
+            while (ALGO_SELECT_LESS_(++i, 0)) {}
+            while (ALGO_SELECT_LESS_(0, --j)) {}
+        }
+        algo_sort_swap_(ALGO_SELECT_AT_(0), ALGO_SELECT_AT_(j), elem_size);
+
+        if (k == j) return;
+        if (k < j) {
+            n = j;
+        } else {
+            a += (j + 1) * elem_size;
+            n -= j + 1;
+            k -= j + 1;
+        }
+    }
+#undef ALGO_SELECT_LESS_
+#undef ALGO_SELECT_AT_
+    algo_sort_insertion_(a, 0, n, elem_size, cmp, ctx);
+}
+
+/* Typed macro */
+#define ALGO_SELECT_TYPED(array, len, Type, k, cmp_expr, ctx) \
+    algo_select((array), (len), sizeof(Type), (k), (algo_cmp_fn)(cmp_expr), (ctx))
+
+/* ============================================================
+   Typed partition generator
+   ============================================================ */
+
+/*
+    DEFINE_PARTITION(Type, pred_expr)
+      pred_expr is evaluated with `a` bound to `const Type*` and is true
+      for elements that belong in front. Generates:
+        size_t partition_##Type(Type* array, size_t len)
+        size_t stable_partition_##Type(Type* array, size_t len, Arena* scratch)
+      Same contracts as algo_partition / algo_stable_partition.
+*/
+#define DEFINE_PARTITION(Type, pred_expr) \
+static inline bool partition_##Type##_pred_(const Type* a) \
+{ \
+    return (pred_expr); \
+} \
+\
+static inline size_t partition_##Type(Type* array, size_t len) \
+{ \
+    if (!array) return 0; \
+    size_t w = 0; \
+    for (size_t i = 0; i < len; ++i) { \
+        Type t = array[i]; \
+        bool keep = partition_##Type##_pred_(&t); \
+        array[i] = array[w]; \
+        array[w] = t; \
+        w += keep; \
+    } \
+    return w; \
+} \
+\
+static inline size_t stable_partition_##Type##_inplace_(Type* a, size_t n) \
+{ \
+    if (n == 1) return partition_##Type##_pred_(&a[0]); \
+    size_t mid = n / 2; \
+    size_t l = stable_partition_##Type##_inplace_(a, mid); \
+    size_t r = mid + stable_partition_##Type##_inplace_(a + mid, n - mid); \
+    if (l < mid && mid < r) algo_sort_rotate_((char*)a, l, mid, r, sizeof(Type)); \
+    return l + (r - mid); \
+} \
+\
+static inline size_t stable_partition_##Type(Type* array, size_t len, Arena* scratch) \
+{ \
+    if (!array || len == 0) return 0; \
+    Type* temp = NULL; \
+    ArenaMark mark = arena_mark(scratch); \
+    if (scratch && len <= SIZE_MAX / sizeof(Type)) temp = arena_alloc_array(scratch, Type, len); \
+    if (!temp) return stable_partition_##Type##_inplace_(array, len); \
+    size_t w = 0, t = 0; \
+    for (size_t i = 0; i < len; ++i) { \
+        Type x = array[i]; \
+        bool keep = partition_##Type##_pred_(&x); \
+        array[w] = x; \
+        temp[t] = x; \
+        w += keep; \
+        t += !keep; \
+    } \
+    memcpy(array + w, temp, t * sizeof(Type)); \
+    arena_reset_to(scratch, mark); \
+    return w; \
+}
+
+#endif /* CANON_C_ALGO_PARTITION_H */
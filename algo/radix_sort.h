@@ -0,0 +1,261 @@
+#ifndef CANON_C_ALGO_RADIX_SORT_H
+#define CANON_C_ALGO_RADIX_SORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "core/arena.h"
+
+/*
+    radix_sort.h — Radix sorts for fixed-width keys and byte strings
+
+    LSD (least significant digit first):
+      - 8-bit digits, one counting pass for all digits up front.
+      - Passes where every key shares the digit are skipped.
+      - Stable; O(n * key bytes).
+      - Keys are unsigned integers; radix_key_* map signed and
+        floating-point values to unsigned keys with the same order.
+
+    MSD (most significant byte first) for NUL-terminated strings:
+      - Byte-wise buckets; the largest bucket is sorted in a loop and
+        the others recursively, so recursion depth is O(log n).
+        Small buckets use insertion sort.
+      - Stable; order matches strcmp.
+
+    Scratch memory is explicit: a caller buffer of `len` elements,
+    or an Arena that is rolled back before returning.
+    Functions return false (array untouched) if scratch is missing.
+*/
+
+/* Below this many elements, insertion sort beats counting passes */
+#define ALGO_RADIX_SMALL 32
+
+/* ============================================================
+   Order-preserving key transforms
+   ============================================================ */
+
+static inline uint32_t radix_key_i32(int32_t v) { return (uint32_t)v ^ UINT32_C(0x80000000); }
+static inline uint64_t radix_key_i64(int64_t v) { return (uint64_t)v ^ UINT64_C(0x8000000000000000); }
+
+/* Negative floats: flip all bits; positive floats: flip the sign bit */
+static inline uint32_t radix_key_f32(float v)
+{
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof bits);
+    return (bits & UINT32_C(0x80000000)) ? ~bits : bits ^ UINT32_C(0x80000000);
+}
+
+static inline uint64_t radix_key_f64(double v)
+{
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof bits);
+    return (bits & UINT64_C(0x8000000000000000)) ? ~bits : bits ^ UINT64_C(0x8000000000000000);
+}
+
+/* ============================================================
+   LSD radix sort generator
+   ============================================================ */
+
+/*
+    DEFINE_RADIX_SORT(Type, KeyType, key_expr)
+      Generates, for arrays of Type keyed by an unsigned KeyType
+      (uint8_t / uint16_t / uint32_t / uint64_t):
+        bool radix_sort_##Type(Type* array, size_t len, Type* scratch)
+        bool radix_sort_##Type##_arena(Type* array, size_t len, Arena* scratch)
+      key_expr is evaluated with `a` bound to `const Type*` and must
+      yield the KeyType key (e.g. `a->id`, `radix_key_f64(a->score)`).
+*/
+#define DEFINE_RADIX_SORT(Type, KeyType, key_expr) \
+    DEFINE_RADIX_SORT_NAMED_(radix_sort_##Type, Type, KeyType, key_expr)
+
+#define DEFINE_RADIX_SORT_NAMED_(name, Type, KeyType, key_expr) \
+static inline KeyType name##_key_(const Type* a) \
+{ \
+    return (KeyType)(key_expr); \
+} \
+\
+static inline void name##_insertion_(Type* array, size_t len) \
+{ \
+    for (size_t i = 1; i < len; ++i) { \
+        Type t = array[i]; \
+        KeyType k = name##_key_(&t); \
+        size_t j = i; \
+        while (j > 0 && k < name##_key_(&array[j - 1])) { \
+            array[j] = array[j - 1]; \
+            --j; \
+        } \
+        array[j] = t; \
+    } \
+} \
+\
+static inline bool name(Type* array, size_t len, Type* scratch) \
+{ \
+    if (!array) return false; \
+    if (len < 2) return true; \
+    if (len <= ALGO_RADIX_SMALL) { \
+        name##_insertion_(array, len); \
+        return true; \
+    } \
+    if (!scratch) return false; \
+    \
+    enum { DIGITS = sizeof(KeyType) }; \
+    size_t counts[DIGITS][256]; \
+    memset(counts, 0, sizeof counts); \
+    for (size_t i = 0; i < len; ++i) { \
+        KeyType k = name##_key_(&array[i]); \
+        for (size_t d = 0; d < DIGITS; ++d) { \
+            counts[d][(k >> (8 * d)) & 0xFF]++; \
+        } \
+    } \
+    \
+    Type* src = array; \
+    Type* dst = scratch; \
+    for (size_t d = 0; d < DIGITS; ++d) { \
+        size_t* c = counts[d]; \
+        /* Every key has the same digit here: the pass would be a copy */ \
+        if (c[(name##_key_(&src[0]) >> (8 * d)) & 0xFF] == len) continue; \
+        \
+        size_t offset = 0; \
+        for (size_t b = 0; b < 256; ++b) { \
+            size_t n = c[b]; \
+            c[b] = offset; \
+            offset += n; \
+        } \
+        for (size_t i = 0; i < len; ++i) { \
+            size_t b = (name##_key_(&src[i]) >> (8 * d)) & 0xFF; \
+            dst[c[b]++] = src[i]; \
+        } \
+        Type* t = src; \
+        src = dst; \
+        dst = t; \
+    } \
+    if (src != array) memcpy(array, src, len * sizeof(Type)); \
+    return true; \
+} \
+\
+static inline bool name##_arena(Type* array, size_t len, Arena* scratch) \
+{ \
+    if (!array) return false; \
+    if (len <= ALGO_RADIX_SMALL) return name(array, len, NULL); \
+    if (!scratch || len > SIZE_MAX / sizeof(Type)) return false; \
+    ArenaMark mark = arena_mark(scratch); \
+    Type* temp = arena_alloc_array(scratch, Type, len); \
+    if (!temp) return false; \
+    bool ok = name(array, len, temp); \
+    arena_reset_to(scratch, mark); \
+    return ok; \
+}
+
+/* ============================================================
+   Primitive arrays
+   ============================================================ */
+
+DEFINE_RADIX_SORT_NAMED_(radix_sort_u32, uint32_t, uint32_t, *a)
+DEFINE_RADIX_SORT_NAMED_(radix_sort_u64, uint64_t, uint64_t, *a)
+DEFINE_RADIX_SORT_NAMED_(radix_sort_i32, int32_t,  uint32_t, radix_key_i32(*a))
+DEFINE_RADIX_SORT_NAMED_(radix_sort_i64, int64_t,  uint64_t, radix_key_i64(*a))
+DEFINE_RADIX_SORT_NAMED_(radix_sort_f32, float,    uint32_t, radix_key_f32(*a))
+DEFINE_RADIX_SORT_NAMED_(radix_sort_f64, double,   uint64_t, radix_key_f64(*a))
+
+/* ============================================================
+   MSD radix sort for strings
+   ============================================================ */
+
+/* Stable insertion sort of strings that share their first `depth` bytes */
+static inline void radix_sort_strings_insertion_(const char** s, size_t len, size_t depth)
+{
+    for (size_t i = 1; i < len; ++i) {
+        const char* t = s[i];
+        size_t j = i;
+        while (j > 0 && strcmp(t + depth, s[j - 1] + depth) < 0) {
+            s[j] = s[j - 1];
+            --j;
+        }
+        s[j] = t;
+    }
+}
+
+static inline void radix_sort_strings_msd_(const char** s, const char** scratch, size_t len, size_t depth)
+{
+    for (;;) {
+        if (len <= ALGO_RADIX_SMALL) {
+            radix_sort_strings_insertion_(s, len, depth);
+            return;
+        }
+
+        size_t counts[256] = {0};
+        for (size_t i = 0; i < len; ++i) {
+            counts[(unsigned char)s[i][depth]]++;
+        }
+
+        /* All strings share this byte: advance without moving anything */
+        unsigned char first = (unsigned char)s[0][depth];
+        if (counts[first] == len) {
+            if (first == 0) return;  /* all strings equal */
+            ++depth;
+            continue;
+        }
+
+        size_t starts[256];
+        size_t offset = 0;
+        for (size_t b = 0; b < 256; ++b) {
+            starts[b] = offset;
+            offset += counts[b];
+        }
+        for (size_t i = 0; i < len; ++i) {
+            scratch[starts[(unsigned char)s[i][depth]]++] = s[i];
+        }
+        memcpy(s, scratch, len * sizeof(*s));
+
+        /* Bucket 0 holds strings that ended here; they are all equal.
+           Recurse into every bucket but the largest, then loop on that
+           one: each recursive call gets at most half the strings, so
+           the stack stays O(log n) deep whatever the prefixes. */
+        size_t big = 1;
+        for (size_t b = 2; b < 256; ++b) {
+            if (counts[b] > counts[big]) big = b;
+        }
+        size_t lo = counts[0], big_lo = 0;
+        for (size_t b = 1; b < 256; ++b) {
+            if (b == big) big_lo = lo;
+            else if (counts[b] > 1) radix_sort_strings_msd_(s + lo, scratch, counts[b], depth + 1);
+            lo += counts[b];
+        }
+        if (counts[big] <= 1) return;
+        s += big_lo;
+        len = counts[big];
+        ++depth;
+    }
+}
+
+/*
+   radix_sort_strings(strings, len, scratch):
+   Sorts NUL-terminated strings by bytes (strcmp order), stably.
+   scratch: caller buffer of `len` pointers.
+   Recursion depth is at most log2(len): only buckets smaller than the
+   largest one recurse.
+*/
+static inline bool radix_sort_strings(const char** strings, size_t len, const char** scratch)
+{
+    if (!strings) return false;
+    if (len < 2) return true;
+    if (len > ALGO_RADIX_SMALL && !scratch) return false;
+    radix_sort_strings_msd_(strings, scratch, len, 0);
+    return true;
+}
+
+static inline bool radix_sort_strings_arena(const char** strings, size_t len, Arena* scratch)
+{
+    if (!strings) return false;
+    if (len <= ALGO_RADIX_SMALL) return radix_sort_strings(strings, len, NULL);
+    if (!scratch || len > SIZE_MAX / sizeof(*strings)) return false;
+    ArenaMark mark = arena_mark(scratch);
+    const char** temp = arena_alloc_array(scratch, const char*, len);
+    if (!temp) return false;
+    radix_sort_strings(strings, len, temp);
+    arena_reset_to(scratch, mark);
+    return true;
+}
+
+#endif /* CANON_C_ALGO_RADIX_SORT_H */
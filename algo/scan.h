@@ -0,0 +1,436 @@
+#ifndef CANON_C_ALGO_SCAN_H
+#define CANON_C_ALGO_SCAN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "core/arena.h"
+#include "core/cpu.h"
+#include "parallel.h"
+#include "reduce.h"
+
+/*
+    scan.h — Prefix sums (inclusive / exclusive / segmented / parallel)
+
+      inclusive: out[i] = in[0] + ... + in[i]
+      exclusive: out[i] = in[0] + ... + in[i-1]   (out[0] = 0)
+
+    Exclusive scans turn counts into offsets (bucketing, compaction,
+    CSR row starts); they return the grand total, i.e. the value that
+    belongs one past the last offset.
+
+    Output goes to a caller buffer of len elements; out may equal in.
+    Typed for u32, i32, u64, i64 (wrapping, like unsigned arithmetic)
+    and float, double. Sequential scans use AVX2 when the CPU has it:
+    each vector is scanned in registers and the running total carried
+    from one vector to the next, so the only serial dependency is one
+    add and one broadcast per vector instead of one add per element.
+
+    Floating point: the vector scan and the parallel scan group the
+    additions differently from a plain loop, so results can differ from
+    one in the last bits (deterministically, for a given ISA).
+
+    Parallel scans (two passes over caller workers, see parallel.h):
+      1. every chunk is summed (reduce.h kernels)
+      2. the chunk sums are scanned on the calling thread
+      3. every chunk is scanned, starting from its offset
+    The input is read twice and the output written once. Chunking only
+    depends on len, as for the other parallel algorithms.
+
+    Segmented scans restart the running sum wherever flags[i] is true.
+
+    ALGO_SCAN_INCLUSIVE_TYPED / ALGO_SCAN_EXCLUSIVE_TYPED scan any type
+    with a caller-supplied combine function.
+*/
+
+/* ============================================================
+   AVX2 kernels (internal, x86 only)
+   ============================================================ */
+
+#if CANON_C_X86_SIMD
+
+/* In-register inclusive scan of one vector: log-step within each
+   128-bit half, then the low half's last element added to the high half */
+CANON_C_TARGET("avx2")
+static inline __m256i algo_scan_vec_u32_(__m256i x)
+{
+    x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+    x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+    __m256i lo = _mm256_permute2x128_si256(x, x, 0x08);  /* [0, low half] */
+    return _mm256_add_epi32(x, _mm256_shuffle_epi32(lo, 0xFF));
+}
+
+CANON_C_TARGET("avx2")
+static inline __m256i algo_scan_vec_u64_(__m256i x)
+{
+    x = _mm256_add_epi64(x, _mm256_slli_si256(x, 8));
+    __m256i lo = _mm256_permute2x128_si256(x, x, 0x08);
+    return _mm256_add_epi64(x, _mm256_shuffle_epi32(lo, 0xEE));
+}
+
+CANON_C_TARGET("avx2")
+static inline __m256 algo_scan_vec_f32_(__m256 x)
+{
+    x = _mm256_add_ps(x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 4)));
+    x = _mm256_add_ps(x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 8)));
+    __m256 lo = _mm256_permute2f128_ps(x, x, 0x08);
+    return _mm256_add_ps(x, _mm256_shuffle_ps(lo, lo, 0xFF));
+}
+
+CANON_C_TARGET("avx2")
+static inline __m256d algo_scan_vec_f64_(__m256d x)
+{
+    x = _mm256_add_pd(x, _mm256_castsi256_pd(_mm256_slli_si256(_mm256_castpd_si256(x), 8)));
+    __m256d lo = _mm256_permute2f128_pd(x, x, 0x08);
+    return _mm256_add_pd(x, _mm256_permute_pd(lo, 0xF));
+}
+
+/* Broadcast the last element (the running total after this vector) */
+CANON_C_TARGET("avx2") static inline __m256i algo_scan_last_u32_(__m256i v) { return _mm256_permutevar8x32_epi32(v, _mm256_set1_epi32(7)); }
+CANON_C_TARGET("avx2") static inline __m256i algo_scan_last_u64_(__m256i v) { return _mm256_permute4x64_epi64(v, 0xFF); }
+CANON_C_TARGET("avx2") static inline __m256  algo_scan_last_f32_(__m256 v)  { return _mm256_permutevar8x32_ps(v, _mm256_set1_epi32(7)); }
+CANON_C_TARGET("avx2") static inline __m256d algo_scan_last_f64_(__m256d v) { return _mm256_permute4x64_pd(v, 0xFF); }
+
+/* Exclusive form of an inclusive vector v: [carry, v0, v1, ...] */
+CANON_C_TARGET("avx2")
+static inline __m256i algo_scan_shift_u32_(__m256i v, __m256i carry)
+{
+    __m256i s = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6));
+    return _mm256_blend_epi32(s, carry, 0x01);
+}
+
+CANON_C_TARGET("avx2")
+static inline __m256i algo_scan_shift_u64_(__m256i v, __m256i carry)
+{
+    return _mm256_blend_epi32(_mm256_permute4x64_epi64(v, _MM_SHUFFLE(2, 1, 0, 0)), carry, 0x03);
+}
+
+CANON_C_TARGET("avx2")
+static inline __m256 algo_scan_shift_f32_(__m256 v, __m256 carry)
+{
+    __m256 s = _mm256_permutevar8x32_ps(v, _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6));
+    return _mm256_blend_ps(s, carry, 0x01);
+}
+
+CANON_C_TARGET("avx2")
+static inline __m256d algo_scan_shift_f64_(__m256d v, __m256d carry)
+{
+    return _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(2, 1, 0, 0)), carry, 0x01);
+}
+
+CANON_C_TARGET("avx2") static inline __m256i algo_scan_set1_u32_(uint32_t x) { return _mm256_set1_epi32((int)x); }
+CANON_C_TARGET("avx2") static inline __m256i algo_scan_set1_u64_(uint64_t x) { return _mm256_set1_epi64x((long long)x); }
+CANON_C_TARGET("avx2") static inline __m256  algo_scan_set1_f32_(float x)    { return _mm256_set1_ps(x); }
+CANON_C_TARGET("avx2") static inline __m256d algo_scan_set1_f64_(double x)   { return _mm256_set1_pd(x); }
+
+CANON_C_TARGET("avx2") static inline __m256i algo_scan_load_u32_(const uint32_t* p) { return _mm256_loadu_si256((const __m256i*)p); }
+CANON_C_TARGET("avx2") static inline __m256i algo_scan_load_u64_(const uint64_t* p) { return _mm256_loadu_si256((const __m256i*)p); }
+CANON_C_TARGET("avx2") static inline __m256  algo_scan_load_f32_(const float* p)    { return _mm256_loadu_ps(p); }
+CANON_C_TARGET("avx2") static inline __m256d algo_scan_load_f64_(const double* p)   { return _mm256_loadu_pd(p); }
+
+CANON_C_TARGET("avx2") static inline void algo_scan_store_u32_(uint32_t* p, __m256i v) { _mm256_storeu_si256((__m256i*)p, v); }
+CANON_C_TARGET("avx2") static inline void algo_scan_store_u64_(uint64_t* p, __m256i v) { _mm256_storeu_si256((__m256i*)p, v); }
+CANON_C_TARGET("avx2") static inline void algo_scan_store_f32_(float* p, __m256 v)     { _mm256_storeu_ps(p, v); }
+CANON_C_TARGET("avx2") static inline void algo_scan_store_f64_(double* p, __m256d v)   { _mm256_storeu_pd(p, v); }
+
+CANON_C_TARGET("avx2") static inline __m256i algo_scan_add_u32_(__m256i a, __m256i b) { return _mm256_add_epi32(a, b); }
+CANON_C_TARGET("avx2") static inline __m256i algo_scan_add_u64_(__m256i a, __m256i b) { return _mm256_add_epi64(a, b); }
+CANON_C_TARGET("avx2") static inline __m256  algo_scan_add_f32_(__m256 a, __m256 b)   { return _mm256_add_ps(a, b); }
+CANON_C_TARGET("avx2") static inline __m256d algo_scan_add_f64_(__m256d a, __m256d b) { return _mm256_add_pd(a, b); }
+
+/* Scans starting from `carry`; return the running total after the last element */
+#define ALGO_SCAN_AVX2_(S, T, VT, LANES) \
+CANON_C_TARGET("avx2") \
+static inline T algo_scan_incl_##S##_avx2_(const T* in, T* out, size_t n, T carry) \
+{ \
+    VT c = algo_scan_set1_##S##_(carry); \
+    size_t i = 0; \
+    for (; i + (LANES) <= n; i += (LANES)) { \
+        VT v = algo_scan_add_##S##_(algo_scan_vec_##S##_(algo_scan_load_##S##_(in + i)), c); \
+        algo_scan_store_##S##_(out + i, v); \
+        c = algo_scan_last_##S##_(v); \
+    } \
+    T s = i ? out[i - 1] : carry; \
+    for (; i < n; ++i) { \
+        s += in[i]; \
+        out[i] = s; \
+    } \
+    return s; \
+} \
+\
+CANON_C_TARGET("avx2") \
+static inline T algo_scan_excl_##S##_avx2_(const T* in, T* out, size_t n, T carry) \
+{ \
+    VT c = algo_scan_set1_##S##_(carry); \
+    size_t i = 0; \
+    for (; i + (LANES) <= n; i += (LANES)) { \
+        VT v = algo_scan_add_##S##_(algo_scan_vec_##S##_(algo_scan_load_##S##_(in + i)), c); \
+        algo_scan_store_##S##_(out + i, algo_scan_shift_##S##_(v, c)); \
+        c = algo_scan_last_##S##_(v); \
+    } \
+    T s; \
+    algo_scan_store_first_##S##_(&s, c); \
+    for (; i < n; ++i) { \
+        T x = in[i]; \
+        out[i] = s; \
+        s += x; \
+    } \
+    return s; \
+}
+
+CANON_C_TARGET("avx2") static inline void algo_scan_store_first_u32_(uint32_t* p, __m256i v) { *p = (uint32_t)_mm256_cvtsi256_si32(v); }
+CANON_C_TARGET("avx2") static inline void algo_scan_store_first_u64_(uint64_t* p, __m256i v) { _mm_storel_epi64((__m128i*)p, _mm256_castsi256_si128(v)); }
+CANON_C_TARGET("avx2") static inline void algo_scan_store_first_f32_(float* p, __m256 v)     { *p = _mm256_cvtss_f32(v); }
+CANON_C_TARGET("avx2") static inline void algo_scan_store_first_f64_(double* p, __m256d v)   { *p = _mm256_cvtsd_f64(v); }
+
+ALGO_SCAN_AVX2_(u32, uint32_t, __m256i, 8)
+ALGO_SCAN_AVX2_(u64, uint64_t, __m256i, 4)
+ALGO_SCAN_AVX2_(f32, float,    __m256,  8)
+ALGO_SCAN_AVX2_(f64, double,   __m256d, 4)
+
+#define ALGO_SCAN_SIMD_(kind, S) \
+    if (algo_reduce_use_avx2_()) return algo_scan_##kind##_##S##_avx2_(in, out, len, carry);
+#else
+#define ALGO_SCAN_SIMD_(kind, S)
+#endif /* CANON_C_X86_SIMD */
+
+/* ============================================================
+   Typed scans
+   ============================================================ */
+
+/*
+   For S in u32, u64, f32, f64 (T the element type):
+
+     T algo_scan_inclusive_##S(const T* in, T* out, size_t len)
+     T algo_scan_exclusive_##S(const T* in, T* out, size_t len)
+         Return the total of all elements (0 on invalid input).
+
+     bool algo_scan_inclusive_parallel_##S(in, out, len, total, scratch, workers)
+     bool algo_scan_exclusive_parallel_##S(in, out, len, total, scratch, workers)
+         total:   optional, receives the sum of all elements
+         scratch: Arena for one T per chunk, rolled back before
+                  returning (not needed when len fits in one chunk)
+         Returns false (out untouched) on invalid input or missing scratch.
+
+     T algo_scan_inclusive_segmented_##S(in, flags, out, len)
+     T algo_scan_exclusive_segmented_##S(in, flags, out, len)
+         flags[i] true starts a new segment at i (flags[0] is implied).
+         Return the total of the last segment.
+
+   The i32 / i64 versions have the same signatures and share the
+   unsigned kernels (two's complement addition is the same operation).
+*/
+#define ALGO_SCAN_DEFINE_(S, T, sum_expr) \
+static inline T algo_scan_incl_##S##_(const T* in, T* out, size_t len, T carry) \
+{ \
+    ALGO_SCAN_SIMD_(incl, S) \
+    T s = carry; \
+    for (size_t i = 0; i < len; ++i) { \
+        s += in[i]; \
+        out[i] = s; \
+    } \
+    return s; \
+} \
+\
+static inline T algo_scan_excl_##S##_(const T* in, T* out, size_t len, T carry) \
+{ \
+    ALGO_SCAN_SIMD_(excl, S) \
+    T s = carry; \
+    for (size_t i = 0; i < len; ++i) { \
+        T x = in[i]; \
+        out[i] = s; \
+        s += x; \
+    } \
+    return s; \
+} \
+\
+static inline T algo_scan_inclusive_##S(const T* in, T* out, size_t len) \
+{ \
+    if (!in || !out) return 0; \
+    return algo_scan_incl_##S##_(in, out, len, 0); \
+} \
+\
+static inline T algo_scan_exclusive_##S(const T* in, T* out, size_t len) \
+{ \
+    if (!in || !out) return 0; \
+    return algo_scan_excl_##S##_(in, out, len, 0); \
+} \
+\
+typedef struct { \
+    const T* in; \
+    T* out; \
+    size_t len; \
+    size_t chunk_len; \
+    T* offsets; \
+    bool inclusive; \
+} AlgoScanParallel_##S##_; \
+\
+static inline void algo_scan_sum_task_##S##_(void* arg, size_t c) \
+{ \
+    const AlgoScanParallel_##S##_* p = (const AlgoScanParallel_##S##_*)arg; \
+    size_t lo = c * p->chunk_len; \
+    size_t n = p->len - lo > p->chunk_len ? p->chunk_len : p->len - lo; \
+    const T* chunk = p->in + lo; \
+    p->offsets[c] = (T)(sum_expr); \
+} \
+\
+static inline void algo_scan_task_##S##_(void* arg, size_t c) \
+{ \
+    const AlgoScanParallel_##S##_* p = (const AlgoScanParallel_##S##_*)arg; \
+    size_t lo = c * p->chunk_len; \
+    size_t n = p->len - lo > p->chunk_len ? p->chunk_len : p->len - lo; \
+    if (p->inclusive) algo_scan_incl_##S##_(p->in + lo, p->out + lo, n, p->offsets[c]); \
+    else              algo_scan_excl_##S##_(p->in + lo, p->out + lo, n, p->offsets[c]); \
+} \
+\
+static inline bool algo_scan_parallel_##S##_( \
+    const T* in, T* out, size_t len, bool inclusive, T* total, Arena* scratch, const AlgoWorkers* workers) \
+{ \
+    if (!in || !out) return false; \
+    size_t chunk_len = algo_parallel_chunk_len_(sizeof(T)); \
+    size_t chunks = algo_parallel_chunks_(len, chunk_len); \
+    if (chunks <= 1) { \
+        T t = inclusive ? algo_scan_incl_##S##_(in, out, len, 0) : algo_scan_excl_##S##_(in, out, len, 0); \
+        if (total) *total = t; \
+        return true; \
+    } \
+    if (!scratch) return false; \
+    ArenaMark mark = arena_mark(scratch); \
+    T* offsets = arena_alloc_array(scratch, T, chunks); \
+    if (!offsets) return false; \
+    AlgoScanParallel_##S##_ p = { \
+        .in = in, .out = out, .len = len, .chunk_len = chunk_len, \
+        .offsets = offsets, .inclusive = inclusive, \
+    }; \
+    algo_workers_run(workers, algo_scan_sum_task_##S##_, &p, chunks); \
+    T run = 0; \
+    for (size_t c = 0; c < chunks; ++c) { \
+        T s = offsets[c]; \
+        offsets[c] = run; \
+        run += s; \
+    } \
+    algo_workers_run(workers, algo_scan_task_##S##_, &p, chunks); \
+    if (total) *total = run; \
+    arena_reset_to(scratch, mark); \
+    return true; \
+} \
+\
+static inline bool algo_scan_inclusive_parallel_##S( \
+    const T* in, T* out, size_t len, T* total, Arena* scratch, const AlgoWorkers* workers) \
+{ \
+    return algo_scan_parallel_##S##_(in, out, len, true, total, scratch, workers); \
+} \
+\
+static inline bool algo_scan_exclusive_parallel_##S( \
+    const T* in, T* out, size_t len, T* total, Arena* scratch, const AlgoWorkers* workers) \
+{ \
+    return algo_scan_parallel_##S##_(in, out, len, false, total, scratch, workers); \
+} \
+\
+static inline T algo_scan_inclusive_segmented_##S(const T* in, const bool* flags, T* out, size_t len) \
+{ \
+    if (!in || !flags || !out) return 0; \
+    T s = 0; \
+    for (size_t i = 0; i < len; ++i) { \
+        s = (flags[i] ? (T)0 : s) + in[i]; \
+        out[i] = s; \
+    } \
+    return s; \
+} \
+\
+static inline T algo_scan_exclusive_segmented_##S(const T* in, const bool* flags, T* out, size_t len) \
+{ \
+    if (!in || !flags || !out) return 0; \
+    T s = 0; \
+    for (size_t i = 0; i < len; ++i) { \
+        T x = in[i]; \
+        s = flags[i] ? (T)0 : s; \
+        out[i] = s; \
+        s += x; \
+    } \
+    return s; \
+}
+
+ALGO_SCAN_DEFINE_(u32, uint32_t, algo_sum_i32((const int32_t*)chunk, n))
+ALGO_SCAN_DEFINE_(u64, uint64_t, algo_sum_i64((const int64_t*)chunk, n))
+ALGO_SCAN_DEFINE_(f32, float,    algo_sum_f32(chunk, n, ALGO_SUM_FAST))
+ALGO_SCAN_DEFINE_(f64, double,   algo_sum_f64(chunk, n, ALGO_SUM_FAST))
+
+/* Signed integers: same bits, same kernels */
+#define ALGO_SCAN_SIGNED_(S, T, U, UT) \
+static inline T algo_scan_inclusive_##S(const T* in, T* out, size_t len) \
+{ \
+    return (T)algo_scan_inclusive_##U((const UT*)in, (UT*)out, len); \
+} \
+\
+static inline T algo_scan_exclusive_##S(const T* in, T* out, size_t len) \
+{ \
+    return (T)algo_scan_exclusive_##U((const UT*)in, (UT*)out, len); \
+} \
+\
+static inline bool algo_scan_inclusive_parallel_##S( \
+    const T* in, T* out, size_t len, T* total, Arena* scratch, const AlgoWorkers* workers) \
+{ \
+    return algo_scan_inclusive_parallel_##U((const UT*)in, (UT*)out, len, (UT*)total, scratch, workers); \
+} \
+\
+static inline bool algo_scan_exclusive_parallel_##S( \
+    const T* in, T* out, size_t len, T* total, Arena* scratch, const AlgoWorkers* workers) \
+{ \
+    return algo_scan_exclusive_parallel_##U((const UT*)in, (UT*)out, len, (UT*)total, scratch, workers); \
+} \
+\
+static inline T algo_scan_inclusive_segmented_##S(const T* in, const bool* flags, T* out, size_t len) \
+{ \
+    return (T)algo_scan_inclusive_segmented_##U((const UT*)in, flags, (UT*)out, len); \
+} \
+\
+static inline T algo_scan_exclusive_segmented_##S(const T* in, const bool* flags, T* out, size_t len) \
+{ \
+    return (T)algo_scan_exclusive_segmented_##U((const UT*)in, flags, (UT*)out, len); \
+}
+
+ALGO_SCAN_SIGNED_(i32, int32_t, u32, uint32_t)
+ALGO_SCAN_SIGNED_(i64, int64_t, u64, uint64_t)
+
+/* ============================================================
+   Generic typed scans (caller-supplied combine)
+   ============================================================ */
+
+/*
+    ALGO_SCAN_INCLUSIVE_TYPED(out_array, in_array, len, Type, fn)
+      fn signature: void fn(Type* acc, const Type* in)   (acc = acc op in)
+      out[0] = in[0], out[i] = out[i-1] op in[i]
+
+    ALGO_SCAN_EXCLUSIVE_TYPED(out_array, in_array, len, Type, identity, fn)
+      out[0] = identity, out[i] = out[i-1] op in[i-1]
+
+    Same buffer rules as ALGO_MAP_TYPED; out_array may equal in_array.
+*/
+#define ALGO_SCAN_INCLUSIVE_TYPED(out_array, in_array, len, Type, fn) \
+    do { \
+        if ((out_array) && (in_array) && (fn) && (len) > 0) { \
+            const size_t _len = (len); \
+            Type _acc = (in_array)[0]; \
+            (out_array)[0] = _acc; \
+            for (size_t _i = 1; _i < _len; ++_i) { \
+                fn(&_acc, &(in_array)[_i]); \
+                (out_array)[_i] = _acc; \
+            } \
+        } \
+    } while (0)
+
+#define ALGO_SCAN_EXCLUSIVE_TYPED(out_array, in_array, len, Type, identity, fn) \
+    do { \
+        if ((out_array) && (in_array) && (fn)) { \
+            const size_t _len = (len); \
+            Type _acc = (identity); \
+            for (size_t _i = 0; _i < _len; ++_i) { \
+                Type _x = (in_array)[_i]; \
+                (out_array)[_i] = _acc; \
+                fn(&_acc, &_x); \
+            } \
+        } \
+    } while (0)
+
+#endif /* CANON_C_ALGO_SCAN_H */
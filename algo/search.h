@@ -2,16 +2,38 @@
 #define CANON_C_ALGO_SEARCH_H
 
 #include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "core/memory_bulk.h"
 
 /*
     search.h — Binary search utilities (requires sorted input)
 
     All functions assume array is sorted by the same comparator.
+
+    lower_bound / upper_bound return the insertion point in [0, len]:
+      lower_bound: first element not less than key
+      upper_bound: first element greater than key
+    binary_search returns the index of a match or SIZE_MAX.
+
+    The search loop is branchless: the range halves every step with a
+    conditional move, so the step count depends only on len and there
+    is nothing to mispredict. Both possible next midpoints are
+    prefetched while the current comparison is in flight.
+
+    Batch lookups (many keys, same array) interleave the searches so
+    their cache misses overlap.
+
+    DEFINE_SEARCH generates typed versions with the comparison inlined.
 */
 
 typedef int (*algo_cmp_fn)(const void* a, const void* b, void* ctx);
 
-/* Find exact match — returns index or SIZE_MAX if not found */
+/* ============================================================
+   Generic (comparator callback)
+   ============================================================ */
+
+/* First index whose element is not less than key (len if none) */
 static inline size_t algo_lower_bound(
     const void* array,
     size_t len,
@@ -21,34 +43,214 @@ static inline size_t algo_lower_bound(
     void* ctx
 )
 {
-    size_t low = 0;
-    size_t high = len;
-
-    while (low < high) {
-        size_t mid = low + (high - low) / 2;
-        const void* elem = (const char*)array + mid * elem_size;
-        int c = cmp(elem, key, ctx);
-        if (c < 0) {
-            low = mid + 1;
-        } else {
-            high = mid;
+    if (!array || len == 0 || !cmp) return 0;
+    const char* base = (const char*)array;
+    while (len > 1) {
+        size_t half = len / 2;
+        len -= half;
+        mem_prefetch(base + (len / 2) * elem_size);
+        mem_prefetch(base + (half + len / 2) * elem_size);
+        base = cmp(base + half * elem_size, key, ctx) < 0 ? base + half * elem_size : base;
+    }
+    size_t idx = (size_t)(base - (const char*)array) / elem_size;
+    return idx + (cmp(base, key, ctx) < 0);
+}
+
+/* First index whose element is greater than key (len if none) */
+static inline size_t algo_upper_bound(
+    const void* array,
+    size_t len,
+    size_t elem_size,
+    const void* key,
+    algo_cmp_fn cmp,
+    void* ctx
+)
+{
+    if (!array || len == 0 || !cmp) return 0;
+    const char* base = (const char*)array;
+    while (len > 1) {
+        size_t half = len / 2;
+        len -= half;
+        mem_prefetch(base + (len / 2) * elem_size);
+        mem_prefetch(base + (half + len / 2) * elem_size);
+        base = cmp(base + half * elem_size, key, ctx) <= 0 ? base + half * elem_size : base;
+    }
+    size_t idx = (size_t)(base - (const char*)array) / elem_size;
+    return idx + (cmp(base, key, ctx) <= 0);
+}
+
+/* Searches advanced in lockstep by the batch functions */
+#define ALGO_SEARCH_BATCH 16
+
+/*
+   algo_lower_bound_batch:
+     out_idx[i] = algo_lower_bound(array, len, ..., keys + i * key_size, ...)
+     for every i in [0, nkeys).
+     Up to ALGO_SEARCH_BATCH searches step through the array together.
+     The branchless loop takes the same number of steps for every key,
+     so each step issues one independent load per search and prefetches
+     the next probe of each; their cache misses overlap instead of
+     being paid one after another.
+     Keys need not be sorted. Does nothing on invalid input.
+*/
+static inline void algo_lower_bound_batch(
+    const void* array,
+    size_t len,
+    size_t elem_size,
+    const void* keys,
+    size_t nkeys,
+    size_t key_size,
+    algo_cmp_fn cmp,
+    void* ctx,
+    size_t* out_idx
+)
+{
+    if (!keys || !out_idx || !cmp) return;
+    if (!array || len == 0) {
+        for (size_t i = 0; i < nkeys; ++i) out_idx[i] = 0;
+        return;
+    }
+    const char* first = (const char*)array;
+    const char* key_bytes = (const char*)keys;
+    const char* base[ALGO_SEARCH_BATCH];
+
+    for (size_t start = 0; start < nkeys; start += ALGO_SEARCH_BATCH) {
+        size_t count = nkeys - start < ALGO_SEARCH_BATCH ? nkeys - start : ALGO_SEARCH_BATCH;
+        const char* group = key_bytes + start * key_size;
+        for (size_t g = 0; g < count; ++g) base[g] = first;
+
+        size_t n = len;
+        while (n > 1) {
+            size_t half = n / 2;
+            n -= half;
+            for (size_t g = 0; g < count; ++g) {
+                const char* mid = base[g] + half * elem_size;
+                base[g] = cmp(mid, group + g * key_size, ctx) < 0 ? mid : base[g];
+                mem_prefetch(base[g] + (n / 2) * elem_size);
+            }
+        }
+        for (size_t g = 0; g < count; ++g) {
+            size_t idx = (size_t)(base[g] - first) / elem_size;
+            out_idx[start + g] = idx + (cmp(base[g], group + g * key_size, ctx) < 0);
         }
     }
-    return low < len && cmp((const char*)array + low * elem_size, key, ctx) == 0 ? low : SIZE_MAX;
+}
+
+/* Find exact match — returns index of the first match or SIZE_MAX */
+static inline size_t algo_binary_search(
+    const void* array,
+    size_t len,
+    size_t elem_size,
+    const void* key,
+    algo_cmp_fn cmp,
+    void* ctx
+)
+{
+    size_t idx = algo_lower_bound(array, len, elem_size, key, cmp, ctx);
+    if (idx >= len) return SIZE_MAX;
+    return cmp((const char*)array + idx * elem_size, key, ctx) == 0 ? idx : SIZE_MAX;
 }
 
 /* Typed macros */
 #define ALGO_LOWER_BOUND_TYPED(array, len, Type, key, cmp_expr, ctx) \
-    ({ \
-        size_t _idx = SIZE_MAX; \
-        if ((array)) { \
-            _idx = algo_lower_bound((array), (len), sizeof(Type), (key), \
-                                    (algo_cmp_fn)(cmp_expr), (ctx)); \
-        } \
-        _idx; \
-    })
+    algo_lower_bound((array), (len), sizeof(Type), (key), (algo_cmp_fn)(cmp_expr), (ctx))
+
+#define ALGO_UPPER_BOUND_TYPED(array, len, Type, key, cmp_expr, ctx) \
+    algo_upper_bound((array), (len), sizeof(Type), (key), (algo_cmp_fn)(cmp_expr), (ctx))
 
 #define ALGO_BINARY_SEARCH_TYPED(array, len, Type, key, cmp_expr, ctx) \
-    (ALGO_LOWER_BOUND_TYPED(array, len, Type, key, cmp_expr, ctx) != SIZE_MAX)
+    (algo_binary_search((array), (len), sizeof(Type), (key), \
+                        (algo_cmp_fn)(cmp_expr), (ctx)) != SIZE_MAX)
+
+/* ============================================================
+   Typed search generator
+   ============================================================ */
+
+/*
+    DEFINE_SEARCH(Type, less_expr)
+      less_expr is evaluated with `a` and `b` bound to `const Type*`
+      and must be true when *a orders before *b (same as DEFINE_SORT).
+      Generates:
+        size_t search_##Type##_lower_bound(const Type* array, size_t len, const Type* key)
+        size_t search_##Type##_upper_bound(const Type* array, size_t len, const Type* key)
+        size_t search_##Type##_find(const Type* array, size_t len, const Type* key)
+          (index of first match or SIZE_MAX)
+        bool   search_##Type##_contains(const Type* array, size_t len, const Type* key)
+        void   search_##Type##_lower_bound_batch(const Type* array, size_t len,
+                                                 const Type* keys, size_t nkeys, size_t* out_idx)
+          (out_idx[i] = lower bound of keys[i]; see algo_lower_bound_batch)
+*/
+#define DEFINE_SEARCH(Type, less_expr) \
+static inline bool search_##Type##_less_(const Type* a, const Type* b) \
+{ \
+    return (less_expr); \
+} \
+\
+static inline size_t search_##Type##_lower_bound(const Type* array, size_t len, const Type* key) \
+{ \
+    if (!array || len == 0) return 0; \
+    const Type* base = array; \
+    while (len > 1) { \
+        size_t half = len / 2; \
+        len -= half; \
+        mem_prefetch(base + len / 2); \
+        mem_prefetch(base + half + len / 2); \
+        base = search_##Type##_less_(base + half, key) ? base + half : base; \
+    } \
+    return (size_t)(base - array) + search_##Type##_less_(base, key); \
+} \
+\
+static inline size_t search_##Type##_upper_bound(const Type* array, size_t len, const Type* key) \
+{ \
+    if (!array || len == 0) return 0; \
+    const Type* base = array; \
+    while (len > 1) { \
+        size_t half = len / 2; \
+        len -= half; \
+        mem_prefetch(base + len / 2); \
+        mem_prefetch(base + half + len / 2); \
+        base = search_##Type##_less_(key, base + half) ? base : base + half; \
+    } \
+    return (size_t)(base - array) + !search_##Type##_less_(key, base); \
+} \
+\
+static inline size_t search_##Type##_find(const Type* array, size_t len, const Type* key) \
+{ \
+    size_t idx = search_##Type##_lower_bound(array, len, key); \
+    return (idx < len && !search_##Type##_less_(key, array + idx)) ? idx : SIZE_MAX; \
+} \
+\
+static inline bool search_##Type##_contains(const Type* array, size_t len, const Type* key) \
+{ \
+    return search_##Type##_find(array, len, key) != SIZE_MAX; \
+} \
+\
+static inline void search_##Type##_lower_bound_batch( \
+    const Type* array, size_t len, const Type* keys, size_t nkeys, size_t* out_idx) \
+{ \
+    if (!keys || !out_idx) return; \
+    if (!array || len == 0) { \
+        for (size_t i = 0; i < nkeys; ++i) out_idx[i] = 0; \
+        return; \
+    } \
+    const Type* base[ALGO_SEARCH_BATCH]; \
+    for (size_t start = 0; start < nkeys; start += ALGO_SEARCH_BATCH) { \
+        size_t count = nkeys - start < ALGO_SEARCH_BATCH ? nkeys - start : ALGO_SEARCH_BATCH; \
+        const Type* group = keys + start; \
+        for (size_t g = 0; g < count; ++g) base[g] = array; \
+        size_t n = len; \
+        while (n > 1) { \
+            size_t half = n / 2; \
+            n -= half; \
+            for (size_t g = 0; g < count; ++g) { \
+                base[g] = search_##Type##_less_(base[g] + half, group + g) ? base[g] + half : base[g]; \
+                mem_prefetch(base[g] + n / 2); \
+            } \
+        } \
+        for (size_t g = 0; g < count; ++g) { \
+            out_idx[start + g] = (size_t)(base[g] - array) + search_##Type##_less_(base[g], group + g); \
+        } \
+    } \
+}
 
 #endif /* CANON_C_ALGO_SEARCH_H */
@@ -2,49 +2,255 @@
 #define CANON_C_ALGO_SORT_H
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
+#include "core/arena.h"
 
 /*
     sort.h — Generic in-place sorting
 
-    Uses stable merge-sort variant (O(n log n), O(n) extra space optional).
+    Stable merge sort:
+      - Runs of ALGO_SORT_RUN elements are insertion-sorted first.
+      - With a temp buffer (len * elem_size bytes): bottom-up merge,
+        O(n log n), ping-ponging between array and buffer.
+      - Without one: in-place rotation merge (SymMerge), O(n log^2 n),
+        still stable, no extra memory.
     Comparator: negative if a < b, zero if equal, positive if a > b.
-    No allocation unless caller provides temp buffer.
+    No allocation unless caller provides temp buffer or Arena.
 */
 
 typedef int (*algo_cmp_fn)(const void* a, const void* b, void* ctx);
 
-/* Sort array in-place */
+/* Length of the insertion-sorted runs that merging starts from */
+#define ALGO_SORT_RUN 16
+
+/* ============================================================
+   Element moves (internal)
+   ============================================================ */
+
+/* Swap two elements a word at a time, then any trailing bytes */
+static inline void algo_sort_swap_(char* a, char* b, size_t size)
+{
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t t;
+        memcpy(&t, a + i, sizeof t);
+        memcpy(a + i, b + i, sizeof t);
+        memcpy(b + i, &t, sizeof t);
+    }
+    for (; i < size; ++i) {
+        char t = a[i];
+        a[i] = b[i];
+        b[i] = t;
+    }
+}
+
+/* Reverse elements [lo, hi) */
+static inline void algo_sort_reverse_(char* base, size_t lo, size_t hi, size_t size)
+{
+    while (lo + 1 < hi) {
+        --hi;
+        algo_sort_swap_(base + lo * size, base + hi * size, size);
+        ++lo;
+    }
+}
+
+/* Insertion sort of [lo, hi); stable */
+static inline void algo_sort_insertion_(
+    char* base, size_t lo, size_t hi, size_t size, algo_cmp_fn cmp, void* ctx)
+{
+    for (size_t i = lo + 1; i < hi; ++i) {
+        for (size_t j = i; j > lo; --j) {
+            char* a = base + (j - 1) * size;
+            char* b = base + j * size;
+            if (cmp(a, b, ctx) <= 0) break;
+            algo_sort_swap_(a, b, size);
+        }
+    }
+}
+
+/* ============================================================
+   Buffered merge (internal)
+   ============================================================ */
+
+/*
+   Merge src[lo, mid) and src[mid, hi) into dst[lo, hi).
+   Ties take the left element, which keeps the sort stable.
+*/
+static inline void algo_sort_merge_(
+    char* dst, const char* src, size_t lo, size_t mid, size_t hi,
+    size_t size, algo_cmp_fn cmp, void* ctx)
+{
+    /* Already ordered: one bulk copy */
+    if (cmp(src + (mid - 1) * size, src + mid * size, ctx) <= 0) {
+        memcpy(dst + lo * size, src + lo * size, (hi - lo) * size);
+        return;
+    }
+
+    size_t i = lo, j = mid, k = lo;
+    while (i < mid && j < hi) {
+        const char* a = src + i * size;
+        const char* b = src + j * size;
+        if (cmp(b, a, ctx) < 0) {
+            memcpy(dst + k * size, b, size);
+            ++j;
+        } else {
+            memcpy(dst + k * size, a, size);
+            ++i;
+        }
+        ++k;
+    }
+    if (i < mid) memcpy(dst + k * size, src + i * size, (mid - i) * size);
+    if (j < hi)  memcpy(dst + k * size, src + j * size, (hi - j) * size);
+}
+
+/* ============================================================
+   In-place merge (internal, used without temp buffer)
+   ============================================================ */
+
+/* Rotate [lo, hi) so that [mid, hi) comes before [lo, mid) */
+static inline void algo_sort_rotate_(char* base, size_t lo, size_t mid, size_t hi, size_t size)
+{
+    algo_sort_reverse_(base, lo, mid, size);
+    algo_sort_reverse_(base, mid, hi, size);
+    algo_sort_reverse_(base, lo, hi, size);
+}
+
+/*
+   SymMerge (Kim & Kutzner): stable in-place merge of [lo, mid) and [mid, hi)
+   by binary search and rotation. Recursion depth is O(log n).
+*/
+static inline void algo_sort_symmerge_(
+    char* base, size_t lo, size_t mid, size_t hi,
+    size_t size, algo_cmp_fn cmp, void* ctx)
+{
+#define ALGO_SORT_LESS_(x, y) (cmp(base + (x) * size, base + (y) * size, ctx) < 0)
+    if (mid - lo == 1) {
+        /* Single left element: binary search its slot, bubble it there */
+        size_t i = mid, j = hi;
+        while (i < j) {
+            size_t h = i + (j - i) / 2;
+            if (ALGO_SORT_LESS_(h, lo)) i = h + 1; else j = h;
+        }
+        for (size_t k = lo; k + 1 < i; ++k) algo_sort_swap_(base + k * size, base + (k + 1) * size, size);
+        return;
+    }
+    if (hi - mid == 1) {
+        /* Single right element: mirror of the case above */
+        size_t i = lo, j = mid;
+        while (i < j) {
+            size_t h = i + (j - i) / 2;
+            if (!ALGO_SORT_LESS_(mid, h)) i = h + 1; else j = h;
+        }
+        for (size_t k = mid; k > i; --k) algo_sort_swap_(base + k * size, base + (k - 1) * size, size);
+        return;
+    }
+
+    size_t half = lo + (hi - lo) / 2;
+    size_t n = half + mid;
+    size_t start, r;
+    if (mid > half) {
+        start = n - hi;
+        r = half;
+    } else {
+        start = lo;
+        r = mid;
+    }
+    size_t p = n - 1;
+    while (start < r) {
+        size_t c = start + (r - start) / 2;
+        if (!ALGO_SORT_LESS_(p - c, c)) start = c + 1; else r = c;
+    }
+    size_t end = n - start;
+    if (start < mid && mid < end) algo_sort_rotate_(base, start, mid, end, size);
+    if (lo < start && start < half) algo_sort_symmerge_(base, lo, start, half, size, cmp, ctx);
+    if (half < end && end < hi) algo_sort_symmerge_(base, half, end, hi, size, cmp, ctx);
+#undef ALGO_SORT_LESS_
+}
+
+/* ============================================================
+   Sort
+   ============================================================ */
+
+/*
+   algo_sort:
+     Sorts array in place, stably.
+     temp_buffer: optional scratch of at least len * elem_size bytes.
+       Given  → O(n log n) buffered merge sort.
+       NULL   → O(n log^2 n) in-place merge sort (no memory needed).
+     Does nothing on invalid input.
+*/
 static inline void algo_sort(
     void* array,
     size_t len,
     size_t elem_size,
     algo_cmp_fn cmp,
     void* ctx,
-    void* temp_buffer  // optional: if NULL, internal scratch arena needed (not provided here)
+    void* temp_buffer  // optional: len * elem_size bytes of scratch
 )
 {
-    if (!array || len < 2 || !cmp) return;
-    // Simple insertion sort for small arrays
-    if (len < 16) {
-        char* bytes = (char*)array;
-        for (size_t i = 1; i < len; ++i) {
-            for (size_t j = i; j > 0; --j) {
-                const void* a = bytes + (j - 1) * elem_size;
-                const void* b = bytes + j * elem_size;
-                if (cmp(a, b, ctx) <= 0) break;
-                // swap
-                for (size_t k = 0; k < elem_size; ++k) {
-                    char tmp = bytes[j * elem_size + k];
-                    bytes[j * elem_size + k] = bytes[(j - 1) * elem_size + k];
-                    bytes[(j - 1) * elem_size + k] = tmp;
-                }
+    if (!array || len < 2 || !cmp || elem_size == 0) return;
+    char* base = (char*)array;
+
+    for (size_t lo = 0; lo < len; lo += ALGO_SORT_RUN) {
+        size_t hi = (len - lo > ALGO_SORT_RUN) ? lo + ALGO_SORT_RUN : len;
+        algo_sort_insertion_(base, lo, hi, elem_size, cmp, ctx);
+    }
+    if (len <= ALGO_SORT_RUN) return;
+
+    if (!temp_buffer) {
+        for (size_t width = ALGO_SORT_RUN; width < len; width *= 2) {
+            for (size_t lo = 0; lo + width < len; lo += 2 * width) {
+                size_t hi = (len - lo > 2 * width) ? lo + 2 * width : len;
+                algo_sort_symmerge_(base, lo, lo + width, hi, elem_size, cmp, ctx);
             }
         }
         return;
     }
-    // For full merge sort, caller must provide temp_buffer of len * elem_size
-    // Omitted here for brevity — recommend external temp or arena-backed version
+
+    char* src = base;
+    char* dst = (char*)temp_buffer;
+    for (size_t width = ALGO_SORT_RUN; width < len; width *= 2) {
+        for (size_t lo = 0; lo < len; lo += 2 * width) {
+            size_t mid = (len - lo > width) ? lo + width : len;
+            size_t hi = (len - lo > 2 * width) ? lo + 2 * width : len;
+            if (mid < hi) {
+                algo_sort_merge_(dst, src, lo, mid, hi, elem_size, cmp, ctx);
+            } else {
+                memcpy(dst + lo * elem_size, src + lo * elem_size, (hi - lo) * elem_size);
+            }
+        }
+        char* t = src;
+        src = dst;
+        dst = t;
+    }
+    if (src != base) memcpy(base, src, len * elem_size);
+}
+
+/*
+   algo_sort_arena:
+     Like algo_sort, with scratch taken from `scratch` and released
+     (arena rolled back) before returning.
+     Falls back to the in-place merge if the arena is too small.
+*/
+static inline void algo_sort_arena(
+    void* array,
+    size_t len,
+    size_t elem_size,
+    algo_cmp_fn cmp,
+    void* ctx,
+    Arena* scratch
+)
+{
+    if (!array || len < 2 || !cmp || elem_size == 0) return;
+    void* temp = NULL;
+    ArenaMark mark = arena_mark(scratch);
+    if (scratch && len <= SIZE_MAX / elem_size) {
+        temp = arena_alloc(scratch, len * elem_size);
+    }
+    algo_sort(array, len, elem_size, cmp, ctx, temp);
+    if (temp) arena_reset_to(scratch, mark);
 }
 
 /* Strongly typed comparator macro (recommended) */
@@ -56,7 +262,7 @@ static inline void algo_sort(
         (_a < _b ? -1 : (_a > _b ? 1 : 0)); \
     })
 
-/* Typed sort macro */
+/* Typed sort macro (in-place merge, no scratch) */
 #define ALGO_SORT_TYPED(array, len, Type, cmp_expr, ctx) \
     do { \
         if ((array) && (len) >= 2) { \
@@ -65,4 +271,234 @@ static inline void algo_sort(
         } \
     } while (0)
 
+/* Typed sort macro with Arena scratch (O(n log n)) */
+#define ALGO_SORT_ARENA_TYPED(array, len, Type, cmp_expr, ctx, arena) \
+    do { \
+        if ((array) && (len) >= 2) { \
+            algo_sort_arena((array), (len), sizeof(Type), \
+                (algo_cmp_fn)(cmp_expr), (ctx), (arena)); \
+        } \
+    } while (0)
+
+/* ============================================================
+   Type-specialized sort (recommended for hot paths)
+   ============================================================ */
+
+/*
+    DEFINE_SORT(Type, less_expr)
+      Generates sort_##Type(Type* array, size_t len): an unstable
+      introsort in the style of pdqsort, specialized for Type:
+        - less_expr is inlined; it is evaluated with `a` and `b`
+          bound to `const Type*` (e.g. `*a < *b`, `a->key < b->key`)
+        - elements move as Type values, not byte copies
+        - median-of-3 pivot (ninther above 128 elements)
+        - already-partitioned ranges finished by bounded insertion sort
+        - heapsort fallback bounds the worst case at O(n log n)
+      Also generates sort_##Type##_select(array, len, k) (nth_element)
+      and sort_##Type##_is_sorted(array, len).
+      No allocation. Use algo_sort when stability is required.
+*/
+#define ALGO_SORT_INSERTION_MAX   24
+#define ALGO_SORT_NINTHER_MIN     128
+#define ALGO_SORT_PARTIAL_MOVES   8
+
+#define DEFINE_SORT(Type, less_expr) \
+static inline bool sort_##Type##_less_(const Type* a, const Type* b) \
+{ \
+    return (less_expr); \
+} \
+\
+static inline void sort_##Type##_swap_(Type* x, Type* y) \
+{ \
+    Type t = *x; \
+    *x = *y; \
+    *y = t; \
+} \
+\
+static inline void sort_##Type##_insertion_(Type* a, size_t n) \
+{ \
+    for (size_t i = 1; i < n; ++i) { \
+        if (!sort_##Type##_less_(&a[i], &a[i - 1])) continue; \
+        Type t = a[i]; \
+        size_t j = i; \
+        do { \
+            a[j] = a[j - 1]; \
+            --j; \
+        } while (j > 0 && sort_##Type##_less_(&t, &a[j - 1])); \
+        a[j] = t; \
+    } \
+} \
+\
+/* Insertion sort that gives up after a few moves; true if it finished */ \
+static inline bool sort_##Type##_partial_insertion_(Type* a, size_t n) \
+{ \
+    size_t moves = 0; \
+    for (size_t i = 1; i < n; ++i) { \
+        if (!sort_##Type##_less_(&a[i], &a[i - 1])) continue; \
+        Type t = a[i]; \
+        size_t j = i; \
+        do { \
+            a[j] = a[j - 1]; \
+            --j; \
+        } while (j > 0 && sort_##Type##_less_(&t, &a[j - 1])); \
+        a[j] = t; \
+        moves += i - j; \
+        if (moves > ALGO_SORT_PARTIAL_MOVES) return false; \
+    } \
+    return true; \
+} \
+\
+static inline void sort_##Type##_sift_(Type* a, size_t root, size_t n) \
+{ \
+    Type t = a[root]; \
+    for (;;) { \
+        size_t child = 2 * root + 1; \
+        if (child >= n) break; \
+        if (child + 1 < n && sort_##Type##_less_(&a[child], &a[child + 1])) ++child; \
+        if (!sort_##Type##_less_(&t, &a[child])) break; \
+        a[root] = a[child]; \
+        root = child; \
+    } \
+    a[root] = t; \
+} \
+\
+static inline void sort_##Type##_heap_(Type* a, size_t n) \
+{ \
+    for (size_t i = n / 2; i > 0; --i) sort_##Type##_sift_(a, i - 1, n); \
+    for (size_t end = n; end > 1; --end) { \
+        sort_##Type##_swap_(&a[0], &a[end - 1]); \
+        sort_##Type##_sift_(a, 0, end - 1); \
+    } \
+} \
+\
+/* Order *x, *y, *z so that *y holds the median */ \
+static inline void sort_##Type##_sort3_(Type* x, Type* y, Type* z) \
+{ \
+    if (sort_##Type##_less_(y, x)) sort_##Type##_swap_(x, y); \
+    if (sort_##Type##_less_(z, y)) sort_##Type##_swap_(y, z); \
+    if (sort_##Type##_less_(y, x)) sort_##Type##_swap_(x, y); \
+} \
+\
+/* Hoare partition around a[0]; returns the pivot's final index. \
+   Equal keys stop both scans, so duplicates split evenly. \
+   Only the first rightward scan needs a bound: the pivot at a[0] stops \
+   every leftward scan, and each swap leaves a stopper for both sides. */ \
+static inline size_t sort_##Type##_partition_(Type* a, size_t n, bool* swapped) \
+{ \
+    const Type pivot = a[0]; \
+    size_t i = 1, j = n - 1; \
+    *swapped = false; \
+    while (i < n && sort_##Type##_less_(&a[i], &pivot)) ++i; \
+    while (sort_##Type##_less_(&pivot, &a[j])) --j; \
+    while (i < j) { \
+        sort_##Type##_swap_(&a[i], &a[j]); \
+        *swapped = true; \
+        while (sort_##Type##_less_(&a[++i], &pivot)) {} \
+        while (sort_##Type##_less_(&pivot, &a[--j])) {} \
+    } \
+    sort_##Type##_swap_(&a[0], &a[j]); \
+    return j; \
+} \
+\
+/* Move a median-of-3 (ninther for large n) pivot to a[0]; n > 3 */ \
+static inline void sort_##Type##_pivot_(Type* a, size_t n) \
+{ \
+    size_t mid = n / 2; \
+    if (n > ALGO_SORT_NINTHER_MIN) { \
+        sort_##Type##_sort3_(&a[0], &a[mid], &a[n - 1]); \
+        sort_##Type##_sort3_(&a[1], &a[mid - 1], &a[n - 2]); \
+        sort_##Type##_sort3_(&a[2], &a[mid + 1], &a[n - 3]); \
+        sort_##Type##_sort3_(&a[mid - 1], &a[mid], &a[mid + 1]); \
+    } else { \
+        sort_##Type##_sort3_(&a[0], &a[mid], &a[n - 1]); \
+    } \
+    sort_##Type##_swap_(&a[0], &a[mid]); \
+} \
+\
+static inline void sort_##Type##_loop_(Type* a, size_t n, unsigned depth) \
+{ \
+    while (n > ALGO_SORT_INSERTION_MAX) { \
+        if (depth == 0) { \
+            sort_##Type##_heap_(a, n); \
+            return; \
+        } \
+        --depth; \
+        \
+        sort_##Type##_pivot_(a, n); \
+        bool swapped; \
+        size_t p = sort_##Type##_partition_(a, n, &swapped); \
+        size_t left = p, right = n - p - 1; \
+        \
+        /* Input looked sorted: try to finish both sides cheaply */ \
+        if (!swapped \
+            && sort_##Type##_partial_insertion_(a, left) \
+            && sort_##Type##_partial_insertion_(a + p + 1, right)) { \
+            return; \
+        } \
+        \
+        /* Recurse into the smaller side, loop on the larger */ \
+        if (left < right) { \
+            sort_##Type##_loop_(a, left, depth); \
+            a += p + 1; \
+            n = right; \
+        } else { \
+            sort_##Type##_loop_(a + p + 1, right, depth); \
+            n = left; \
+        } \
+    } \
+    sort_##Type##_insertion_(a, n); \
+} \
+\
+/* Sort array in place (unstable, O(n log n) worst case) */ \
+static inline void sort_##Type(Type* array, size_t len) \
+{ \
+    if (!array || len < 2) return; \
+    unsigned depth = 0; \
+    for (size_t n = len; n > 1; n >>= 1) depth += 2; \
+    sort_##Type##_loop_(array, len, depth); \
+} \
+\
+/* \
+   Selection (nth_element): afterwards array[k] holds the element a full \
+   sort would put there, nothing after it is less and nothing before it \
+   is greater. Expected O(n); heapsort fallback bounds it at O(n log n). \
+*/ \
+static inline void sort_##Type##_select(Type* array, size_t len, size_t k) \
+{ \
+    if (!array || k >= len) return; \
+    unsigned depth = 0; \
+    for (size_t m = len; m > 1; m >>= 1) depth += 2; \
+    Type* a = array; \
+    size_t n = len; \
+    while (n > ALGO_SORT_INSERTION_MAX) { \
+        if (depth == 0) { \
+            sort_##Type##_heap_(a, n); \
+            return; \
+        } \
+        --depth; \
+        sort_##Type##_pivot_(a, n); \
+        bool swapped; \
+        size_t p = sort_##Type##_partition_(a, n, &swapped); \
+        if (k == p) return; \
+        if (k < p) { \
+            n = p; \
+        } else { \
+            a += p + 1; \
+            n -= p + 1; \
+            k -= p + 1; \
+        } \
+    } \
+    sort_##Type##_insertion_(a, n); \
+} \
+\
+/* True if array is in non-decreasing order */ \
+static inline bool sort_##Type##_is_sorted(const Type* array, size_t len) \
+{ \
+    if (!array) return true; \
+    for (size_t i = 1; i < len; ++i) { \
+        if (sort_##Type##_less_(&array[i], &array[i - 1])) return false; \
+    } \
+    return true; \
+}
+
 #endif /* CANON_C_ALGO_SORT_H */
@@ -0,0 +1,230 @@
+#ifndef CANON_C_ALGO_SORT_PARALLEL_H
+#define CANON_C_ALGO_SORT_PARALLEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "core/arena.h"
+#include "sort.h"
+#include "parallel.h"
+
+/*
+    sort_parallel.h — Parallel stable merge sort
+
+    1. The array is cut into one chunk per worker; chunks are sorted
+       concurrently with algo_sort (each using its own slice of scratch).
+    2. Sorted runs are merged pairwise, log2(chunks) rounds. Every merge
+       is split by merge path (a diagonal binary search) into pieces of
+       equal output size, so all workers stay busy even when only one
+       pair of runs is left.
+
+    Ties always take the element from the left run, so the result is the
+    unique stable order: identical, byte for byte, to algo_sort on the
+    same input regardless of the worker count or scheduling.
+
+    Threads come from the caller (see parallel.h); scratch of
+    len * elem_size bytes is required. No allocation, no global state.
+*/
+
+/* Below this many elements per worker, extra workers are not used */
+#define ALGO_SORT_PARALLEL_GRAIN 4096
+
+/* ============================================================
+   Internal
+   ============================================================ */
+
+typedef struct {
+    char* src;
+    char* dst;
+    size_t len;
+    size_t size;
+    algo_cmp_fn cmp;
+    void* ctx;
+    size_t chunks;  /* sorted chunks from phase 1 */
+    size_t width;   /* chunks per run in the current round */
+    size_t parts;   /* merge-path pieces per pair of runs */
+} AlgoSortParallel_;
+
+/* Start of chunk c (clamped to the end of the array) */
+static inline size_t algo_sort_parallel_bound_(const AlgoSortParallel_* s, size_t c)
+{
+    return algo_split(s->len, s->chunks, c < s->chunks ? c : s->chunks);
+}
+
+/*
+   Merge path: how many of the first `d` outputs of the stable merge of
+   a[0, na) and b[0, nb) come from a. An element of b precedes one of a
+   only if it compares strictly less.
+*/
+static inline size_t algo_sort_merge_path_(
+    const char* a, size_t na, const char* b, size_t nb, size_t d,
+    size_t size, algo_cmp_fn cmp, void* ctx)
+{
+    size_t lo = d > nb ? d - nb : 0;
+    size_t hi = d < na ? d : na;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (cmp(a + mid * size, b + (d - 1 - mid) * size, ctx) <= 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+/* Stable merge of two separate ranges into dst */
+static inline void algo_sort_merge_into_(
+    char* dst, const char* a, size_t na, const char* b, size_t nb,
+    size_t size, algo_cmp_fn cmp, void* ctx)
+{
+    if (na == 0 || nb == 0 || cmp(a + (na - 1) * size, b, ctx) <= 0) {
+        if (na) memcpy(dst, a, na * size);
+        if (nb) memcpy(dst + na * size, b, nb * size);
+        return;
+    }
+    const char* a_end = a + na * size;
+    const char* b_end = b + nb * size;
+    while (a < a_end && b < b_end) {
+        if (cmp(b, a, ctx) < 0) {
+            memcpy(dst, b, size);
+            b += size;
+        } else {
+            memcpy(dst, a, size);
+            a += size;
+        }
+        dst += size;
+    }
+    if (a < a_end) memcpy(dst, a, (size_t)(a_end - a));
+    if (b < b_end) memcpy(dst, b, (size_t)(b_end - b));
+}
+
+/* Phase 1 task: sort chunk c in place, scratch from the same slice of dst */
+static inline void algo_sort_parallel_chunk_(void* arg, size_t c)
+{
+    AlgoSortParallel_* s = (AlgoSortParallel_*)arg;
+    size_t lo = algo_sort_parallel_bound_(s, c);
+    size_t hi = algo_sort_parallel_bound_(s, c + 1);
+    algo_sort(s->src + lo * s->size, hi - lo, s->size, s->cmp, s->ctx, s->dst + lo * s->size);
+}
+
+/* Phase 2 task: piece `t % parts` of the merge of run pair `t / parts` */
+static inline void algo_sort_parallel_merge_(void* arg, size_t t)
+{
+    AlgoSortParallel_* s = (AlgoSortParallel_*)arg;
+    size_t pair = t / s->parts;
+    size_t part = t % s->parts;
+    size_t first = 2 * pair * s->width;
+
+    size_t lo = algo_sort_parallel_bound_(s, first);
+    size_t mid = algo_sort_parallel_bound_(s, first + s->width);
+    size_t hi = algo_sort_parallel_bound_(s, first + 2 * s->width);
+    const char* a = s->src + lo * s->size;
+    const char* b = s->src + mid * s->size;
+    size_t na = mid - lo, nb = hi - mid;
+
+    size_t d0 = algo_split(na + nb, s->parts, part);
+    size_t d1 = algo_split(na + nb, s->parts, part + 1);
+    if (d0 == d1) return;
+    size_t i0 = algo_sort_merge_path_(a, na, b, nb, d0, s->size, s->cmp, s->ctx);
+    size_t i1 = algo_sort_merge_path_(a, na, b, nb, d1, s->size, s->cmp, s->ctx);
+    size_t j0 = d0 - i0, j1 = d1 - i1;
+
+    algo_sort_merge_into_(s->dst + (lo + d0) * s->size,
+                          a + i0 * s->size, i1 - i0,
+                          b + j0 * s->size, j1 - j0,
+                          s->size, s->cmp, s->ctx);
+}
+
+/* Final task: copy slice c of the scratch result back into the array */
+static inline void algo_sort_parallel_copy_(void* arg, size_t c)
+{
+    AlgoSortParallel_* s = (AlgoSortParallel_*)arg;
+    size_t lo = algo_sort_parallel_bound_(s, c);
+    size_t hi = algo_sort_parallel_bound_(s, c + 1);
+    memcpy(s->dst + lo * s->size, s->src + lo * s->size, (hi - lo) * s->size);
+}
+
+/* ============================================================
+   Parallel sort
+   ============================================================ */
+
+/*
+   algo_sort_parallel:
+     Sorts array in place, stably, using the caller's workers.
+     temp_buffer: required scratch of len * elem_size bytes.
+     workers: NULL (or a single worker) sorts on the calling thread.
+     Result is identical to algo_sort on the same input.
+     Returns false (array untouched) on invalid input or missing scratch.
+*/
+static inline bool algo_sort_parallel(
+    void* array,
+    size_t len,
+    size_t elem_size,
+    algo_cmp_fn cmp,
+    void* ctx,
+    void* temp_buffer,          // len * elem_size bytes of scratch
+    const AlgoWorkers* workers  // optional
+)
+{
+    if (!array || !cmp || elem_size == 0) return false;
+    if (len < 2) return true;
+    if (!temp_buffer) return false;
+
+    size_t chunks = algo_workers_count(workers);
+    size_t max_chunks = len / ALGO_SORT_PARALLEL_GRAIN;
+    if (chunks > max_chunks) chunks = max_chunks;
+    if (chunks <= 1) {
+        algo_sort(array, len, elem_size, cmp, ctx, temp_buffer);
+        return true;
+    }
+
+    AlgoSortParallel_ s = {
+        .src = (char*)array, .dst = (char*)temp_buffer,
+        .len = len, .size = elem_size, .cmp = cmp, .ctx = ctx,
+        .chunks = chunks, .width = 1, .parts = 1,
+    };
+    algo_workers_run(workers, algo_sort_parallel_chunk_, &s, chunks);
+
+    for (; s.width < chunks; s.width *= 2) {
+        size_t pairs = (chunks + 2 * s.width - 1) / (2 * s.width);
+        s.parts = (chunks + pairs - 1) / pairs;
+        algo_workers_run(workers, algo_sort_parallel_merge_, &s, pairs * s.parts);
+        char* t = s.src;
+        s.src = s.dst;
+        s.dst = t;
+    }
+
+    if (s.src != (char*)array) {
+        s.dst = (char*)array;
+        algo_workers_run(workers, algo_sort_parallel_copy_, &s, chunks);
+    }
+    return true;
+}
+
+/*
+   algo_sort_parallel_arena:
+     Like algo_sort_parallel, with scratch taken from `scratch` and
+     released (arena rolled back) before returning.
+     Returns false (array untouched) if the arena is too small.
+*/
+static inline bool algo_sort_parallel_arena(
+    void* array,
+    size_t len,
+    size_t elem_size,
+    algo_cmp_fn cmp,
+    void* ctx,
+    Arena* scratch,
+    const AlgoWorkers* workers
+)
+{
+    if (!array || !cmp || elem_size == 0) return false;
+    if (len < 2) return true;
+    if (!scratch || len > SIZE_MAX / elem_size) return false;
+    ArenaMark mark = arena_mark(scratch);
+    void* temp = arena_alloc(scratch, len * elem_size);
+    if (!temp) return false;
+    bool ok = algo_sort_parallel(array, len, elem_size, cmp, ctx, temp, workers);
+    arena_reset_to(scratch, mark);
+    return ok;
+}
+
+#endif /* CANON_C_ALGO_SORT_PARALLEL_H */
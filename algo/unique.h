@@ -2,16 +2,29 @@
 #define CANON_C_ALGO_UNIQUE_H
 
 #include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "core/arena.h"
 #include "data/vec.h"
 
 /*
     unique.h — Remove consecutive or all duplicates
 
-    Requires sorted input for full deduplication.
+    Consecutive: requires sorted input for full deduplication.
     Preserves order of first occurrence.
+
+    Hashed: any input order, O(n) expected. An open-addressing table
+    (linear probing, load <= 1/2) is carved from a caller Arena and
+    released before returning.
+      keep_order = true   survivors stay in first-occurrence order
+                          (table holds positions, array compacted in place)
+      keep_order = false  survivors come out in table order
+                          (table holds copies, so probes never touch the array)
 */
 
 typedef int (*algo_cmp_fn)(const void* a, const void* b, void* ctx);
+typedef size_t (*algo_hash_fn)(const void* elem, void* ctx);
+typedef bool (*algo_eq_fn)(const void* a, const void* b, void* ctx);
 
 /* Remove consecutive duplicates in-place */
 static inline size_t algo_unique_consecutive(
@@ -61,4 +74,218 @@ static inline size_t algo_unique_consecutive(
         } \
     } while (0)
 
+/* ============================================================
+   Hashed unique (internal helpers)
+   ============================================================ */
+
+/* Smallest table of at least 16 and 2 * len slots; 0 bits if too large */
+static inline unsigned algo_unique_bits_(size_t len)
+{
+    unsigned bits = 4;
+    while (bits < 8 * sizeof(size_t) - 1 && ((size_t)1 << bits) / 2 < len) ++bits;
+    return ((size_t)1 << bits) / 2 < len ? 0 : bits;
+}
+
+/*
+   Fibonacci hashing spreads weak hashes (e.g. identity on integers):
+   the top `bits` bits pick the home slot, the whole word (never 0)
+   is the stored tag that filters most eq calls.
+*/
+static inline uint64_t algo_unique_tag_(size_t hash)
+{
+    return ((uint64_t)hash * UINT64_C(0x9E3779B97F4A7C15)) | 1u;
+}
+
+static inline size_t algo_unique_home_(uint64_t tag, unsigned bits)
+{
+    return (size_t)(tag >> (64 - bits));
+}
+
+/* ============================================================
+   Hashed unique
+   ============================================================ */
+
+/*
+   algo_unique_hashed:
+     Removes all duplicates from unsorted input in place.
+     hash: equal elements must hash equal.  eq: true if equal.
+     keep_order: keep first occurrences in their original order.
+     scratch: Arena for the table (about 2 * len slots), rolled back
+       before returning.
+     Returns the new length, or SIZE_MAX (array untouched) on invalid
+     input or when the table does not fit in scratch.
+*/
+static inline size_t algo_unique_hashed(
+    void* array,
+    size_t len,
+    size_t elem_size,
+    algo_hash_fn hash,
+    algo_eq_fn eq,
+    void* ctx,
+    bool keep_order,
+    Arena* scratch
+)
+{
+    if (!array || !hash || !eq || elem_size == 0) return SIZE_MAX;
+    if (len <= 1) return len;
+    unsigned bits = algo_unique_bits_(len);
+    if (!scratch || bits == 0) return SIZE_MAX;
+
+    /* Slot: 64-bit tag (0 = empty), then a position or an element copy */
+    size_t payload = mem_align(sizeof(uint64_t));
+    size_t stride = keep_order ? payload + sizeof(size_t) : payload + mem_align(elem_size);
+    size_t capacity = (size_t)1 << bits;
+    if (capacity > SIZE_MAX / stride) return SIZE_MAX;
+
+    ArenaMark mark = arena_mark(scratch);
+    char* table = (char*)arena_alloc(scratch, capacity * stride);
+    if (!table) return SIZE_MAX;
+    memset(table, 0, capacity * stride);
+
+    char* bytes = (char*)array;
+    size_t mask = capacity - 1;
+    size_t count = 0;
+
+    for (size_t read = 0; read < len; ++read) {
+        const char* elem = bytes + read * elem_size;
+        uint64_t tag = algo_unique_tag_(hash(elem, ctx));
+        for (size_t i = algo_unique_home_(tag, bits);; i = (i + 1) & mask) {
+            char* slot = table + i * stride;
+            uint64_t slot_tag;
+            memcpy(&slot_tag, slot, sizeof slot_tag);
+            if (slot_tag == 0) {
+                memcpy(slot, &tag, sizeof tag);
+                if (keep_order) {
+                    memcpy(slot + payload, &count, sizeof count);
+                    if (count != read) memcpy(bytes + count * elem_size, elem, elem_size);
+                } else {
+                    memcpy(slot + payload, elem, elem_size);
+                }
+                ++count;
+                break;
+            }
+            if (slot_tag != tag) continue;
+            const char* seen = slot + payload;
+            if (keep_order) {
+                size_t pos;
+                memcpy(&pos, seen, sizeof pos);
+                seen = bytes + pos * elem_size;
+            }
+            if (eq(seen, elem, ctx)) break;
+        }
+    }
+
+    if (!keep_order) {
+        size_t write = 0;
+        for (size_t i = 0; i < capacity && write < count; ++i) {
+            const char* slot = table + i * stride;
+            uint64_t slot_tag;
+            memcpy(&slot_tag, slot, sizeof slot_tag);
+            if (slot_tag != 0) {
+                memcpy(bytes + write * elem_size, slot + payload, elem_size);
+                ++write;
+            }
+        }
+    }
+
+    arena_reset_to(scratch, mark);
+    return count;
+}
+
+/* Vec version: shrinks vec.len; leaves vec untouched if scratch is too small */
+#define ALGO_UNIQUE_HASHED_VEC(vec, Type, hash_fn, eq_fn, ctx, keep_order, scratch) \
+    do { \
+        if ((vec).items) { \
+            size_t _new_len = algo_unique_hashed((vec).items, (vec).len, sizeof(Type), \
+                                                 (algo_hash_fn)(hash_fn), (algo_eq_fn)(eq_fn), \
+                                                 (ctx), (keep_order), (scratch)); \
+            if (_new_len != SIZE_MAX) (vec).len = _new_len; \
+        } \
+    } while (0)
+
+/* ============================================================
+   Typed hashed unique generator
+   ============================================================ */
+
+/*
+    DEFINE_UNIQUE(Type, hash_expr, eq_expr)
+      hash_expr: evaluated with `a` bound to `const Type*`, yields size_t.
+      eq_expr:   evaluated with `a` and `b` bound to `const Type*`.
+      Generates:
+        size_t unique_##Type(Type* array, size_t len, bool keep_order, Arena* scratch)
+      Same contract as algo_unique_hashed, with hash and equality inlined.
+*/
+#define DEFINE_UNIQUE(Type, hash_expr, eq_expr) \
+typedef struct { uint64_t tag; size_t pos; } unique_##Type##_pos_slot_; \
+typedef struct { uint64_t tag; Type value; } unique_##Type##_value_slot_; \
+\
+static inline size_t unique_##Type##_hash_(const Type* a) \
+{ \
+    return (size_t)(hash_expr); \
+} \
+\
+static inline bool unique_##Type##_eq_(const Type* a, const Type* b) \
+{ \
+    return (eq_expr); \
+} \
+\
+static inline size_t unique_##Type##_ordered_(Type* array, size_t len, unsigned bits, Arena* scratch) \
+{ \
+    size_t capacity = (size_t)1 << bits, mask = capacity - 1, count = 0; \
+    if (capacity > SIZE_MAX / sizeof(unique_##Type##_pos_slot_)) return SIZE_MAX; \
+    unique_##Type##_pos_slot_* table = arena_alloc_array_zero(scratch, unique_##Type##_pos_slot_, capacity); \
+    if (!table) return SIZE_MAX; \
+    for (size_t read = 0; read < len; ++read) { \
+        uint64_t tag = algo_unique_tag_(unique_##Type##_hash_(&array[read])); \
+        for (size_t i = algo_unique_home_(tag, bits);; i = (i + 1) & mask) { \
+            if (table[i].tag == 0) { \
+                table[i].tag = tag; \
+                table[i].pos = count; \
+                array[count++] = array[read]; \
+                break; \
+            } \
+            if (table[i].tag == tag && unique_##Type##_eq_(&array[table[i].pos], &array[read])) break; \
+        } \
+    } \
+    return count; \
+} \
+\
+static inline size_t unique_##Type##_unordered_(Type* array, size_t len, unsigned bits, Arena* scratch) \
+{ \
+    size_t capacity = (size_t)1 << bits, mask = capacity - 1, count = 0; \
+    if (capacity > SIZE_MAX / sizeof(unique_##Type##_value_slot_)) return SIZE_MAX; \
+    unique_##Type##_value_slot_* table = arena_alloc_array_zero(scratch, unique_##Type##_value_slot_, capacity); \
+    if (!table) return SIZE_MAX; \
+    for (size_t read = 0; read < len; ++read) { \
+        uint64_t tag = algo_unique_tag_(unique_##Type##_hash_(&array[read])); \
+        for (size_t i = algo_unique_home_(tag, bits);; i = (i + 1) & mask) { \
+            if (table[i].tag == 0) { \
+                table[i].tag = tag; \
+                table[i].value = array[read]; \
+                ++count; \
+                break; \
+            } \
+            if (table[i].tag == tag && unique_##Type##_eq_(&table[i].value, &array[read])) break; \
+        } \
+    } \
+    size_t write = 0; \
+    for (size_t i = 0; i < capacity && write < count; ++i) { \
+        if (table[i].tag != 0) array[write++] = table[i].value; \
+    } \
+    return count; \
+} \
+\
+static inline size_t unique_##Type(Type* array, size_t len, bool keep_order, Arena* scratch) \
+{ \
+    if (!array) return SIZE_MAX; \
+    if (len <= 1) return len; \
+    unsigned bits = algo_unique_bits_(len); \
+    if (!scratch || bits == 0) return SIZE_MAX; \
+    ArenaMark mark = arena_mark(scratch); \
+    size_t count = keep_order ? unique_##Type##_ordered_(array, len, bits, scratch) \
+                              : unique_##Type##_unordered_(array, len, bits, scratch); \
+    arena_reset_to(scratch, mark); \
+    return count; \
+}
+
 #endif /* CANON_C_ALGO_UNIQUE_H */
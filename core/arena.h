@@ -3,6 +3,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
 #include "memory.h"
 
@@ -16,12 +17,44 @@
    - No hidden allocation.
    - Lifetime of allocations visible via arena offset.
 */
+/*
+   Statistics (opt-in):
+   Define CANON_C_MEM_STATS before including this header to record
+   allocation history in every Arena. When undefined, the field and
+   all bookkeeping compile away.
+*/
+typedef struct ArenaStats {
+    size_t peak_offset;    /* highest offset reached */
+    size_t alloc_count;    /* successful allocations */
+    size_t padding_bytes;  /* bytes lost to size rounding and alignment */
+    size_t failed_count;   /* allocations refused for lack of capacity */
+    size_t reset_count;    /* arena_reset / arena_reset_to calls */
+} ArenaStats;
+
+#ifdef CANON_C_MEM_STATS
+#define ARENA_STAT_(stmt) do { stmt; } while (0)
+#else
+#define ARENA_STAT_(stmt) ((void)0)
+#endif
+
 typedef struct Arena {
     uint8_t* buffer;   /* memory buffer */
     size_t capacity;   /* total bytes available */
     size_t offset;     /* current allocation offset */
+#ifdef CANON_C_MEM_STATS
+    ArenaStats stats;  /* allocation history */
+#endif
 } Arena;
 
+/* Record a successful allocation ending at the current offset */
+#define ARENA_STAT_ALLOC_(arena, padding) \
+    ARENA_STAT_( \
+        (arena)->stats.alloc_count++; \
+        (arena)->stats.padding_bytes += (padding); \
+        if ((arena)->offset > (arena)->stats.peak_offset) \
+            (arena)->stats.peak_offset = (arena)->offset \
+    )
+
 /* ============================================================
    Initialize arena
    ============================================================ */
@@ -37,6 +70,7 @@ static inline void arena_init(Arena* arena, void* buffer, size_t capacity) {
     arena->buffer = (uint8_t*)buffer;
     arena->capacity = capacity;
     arena->offset = 0;
+    ARENA_STAT_(arena->stats = (ArenaStats){0});
 }
 
 /* ============================================================
@@ -51,10 +85,14 @@ static inline void arena_init(Arena* arena, void* buffer, size_t capacity) {
 */
 static inline void* arena_alloc(Arena* arena, size_t size) {
     if (!arena || size == 0) return NULL;
-    size = mem_align(size);
-    if (size > arena->capacity - arena->offset) return NULL;
+    size_t aligned = mem_align(size);
+    if (aligned > arena->capacity - arena->offset) {
+        ARENA_STAT_(arena->stats.failed_count++);
+        return NULL;
+    }
     void* ptr = arena->buffer + arena->offset;
-    arena->offset += size;
+    arena->offset += aligned;
+    ARENA_STAT_ALLOC_(arena, aligned - size);
     return ptr;
 }
 
@@ -68,10 +106,14 @@ static inline void* arena_alloc_aligned(Arena* arena, size_t size, size_t alignm
     uintptr_t current = (uintptr_t)(arena->buffer + arena->offset);
     uintptr_t aligned = (current + alignment - 1) & ~(alignment - 1);
     size_t padding = aligned - current;
-    if (arena->offset + padding + size > arena->capacity) return NULL;
+    if (arena->offset + padding + size > arena->capacity) {
+        ARENA_STAT_(arena->stats.failed_count++);
+        return NULL;
+    }
     arena->offset += padding;
     void* ptr = arena->buffer + arena->offset;
     arena->offset += size;
+    ARENA_STAT_ALLOC_(arena, padding);
     return ptr;
 }
 
@@ -83,6 +125,7 @@ static inline void* arena_alloc_aligned(Arena* arena, size_t size, size_t alignm
 static inline void arena_reset(Arena* arena) {
     if (!arena) return;
     arena->offset = 0;
+    ARENA_STAT_(arena->stats.reset_count++);
 }
 
 /* Remaining capacity in bytes */
@@ -103,6 +146,30 @@ static inline ArenaMark arena_mark(Arena* arena) {
 static inline void arena_reset_to(Arena* arena, ArenaMark mark) {
     if (!arena || mark > arena->capacity) return;
     arena->offset = mark;
+    ARENA_STAT_(arena->stats.reset_count++);
+}
+
+/* ============================================================
+   Statistics
+   ============================================================ */
+
+/*
+   arena_stats(arena, out):
+   Copies the arena's statistics to out.
+   Returns false (and zeroes out) when CANON_C_MEM_STATS is not defined.
+*/
+static inline bool arena_stats(const Arena* arena, ArenaStats* out)
+{
+    if (!out) return false;
+    *out = (ArenaStats){0};
+#ifdef CANON_C_MEM_STATS
+    if (!arena) return false;
+    *out = arena->stats;
+    return true;
+#else
+    (void)arena;
+    return false;
+#endif
 }
 
 /* ============================================================
@@ -0,0 +1,237 @@
+#ifndef CANON_C_CORE_ARENA_CHAIN_H
+#define CANON_C_CORE_ARENA_CHAIN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "arena.h"
+
+/*
+    arena_chain.h — Growable arena built from linked blocks
+
+    Same bump-allocation semantics as Arena, but when the current block
+    is exhausted a fresh block is linked instead of returning NULL.
+
+    Blocks come from a caller-supplied provider callback.
+    Blocks retired by a reset are kept on a free list and reused,
+    so after warm-up a reset/alloc cycle requests nothing from the provider.
+
+    Marks are logical offsets that stay valid across block boundaries.
+*/
+
+/* ============================================================
+   Block provider
+   ============================================================ */
+
+/*
+   arena_block_alloc_fn(size, ctx):
+   Returns `size` bytes aligned for max_align_t, or NULL on failure.
+   arena_block_free_fn(block, size, ctx):
+   Receives a block previously returned by the matching alloc callback.
+*/
+typedef void* (*arena_block_alloc_fn)(size_t size, void* ctx);
+typedef void  (*arena_block_free_fn)(void* block, size_t size, void* ctx);
+
+/* ============================================================
+   Chain structure
+   ============================================================ */
+
+/* Block header, stored at the start of every provider block */
+typedef struct ArenaBlock {
+    struct ArenaBlock* next; /* previous block in chain, or next free block */
+    size_t size;             /* total bytes obtained from the provider */
+    size_t base;             /* logical offset of the first usable byte */
+} ArenaBlock;
+
+typedef struct ArenaChain {
+    Arena arena;                      /* view over the current block */
+    ArenaBlock* current;              /* block being bumped (NULL before first alloc) */
+    ArenaBlock* free_list;            /* retired blocks available for reuse */
+    size_t block_size;                /* minimum size requested from provider */
+    arena_block_alloc_fn block_alloc; /* caller-supplied provider */
+    arena_block_free_fn block_free;   /* optional: used by arena_chain_release */
+    void* ctx;                        /* provider context */
+} ArenaChain;
+
+/* Bytes reserved at the start of each block for its header */
+#define ARENA_CHAIN_HEADER_SIZE mem_align(sizeof(ArenaBlock))
+
+/* ============================================================
+   Initialize chain
+   ============================================================ */
+
+/*
+   arena_chain_init(chain, block_size, block_alloc, block_free, ctx):
+   Prepares an empty chain. No block is requested until the first allocation.
+   Preconditions: block_size > ARENA_CHAIN_HEADER_SIZE, block_alloc != NULL.
+   block_free may be NULL if the caller reclaims blocks itself.
+*/
+static inline bool arena_chain_init(
+    ArenaChain* chain,
+    size_t block_size,
+    arena_block_alloc_fn block_alloc,
+    arena_block_free_fn block_free,
+    void* ctx
+)
+{
+    if (!chain || !block_alloc || block_size <= ARENA_CHAIN_HEADER_SIZE) return false;
+    *chain = (ArenaChain){
+        .block_size = block_size,
+        .block_alloc = block_alloc,
+        .block_free = block_free,
+        .ctx = ctx
+    };
+    return true;
+}
+
+/* ============================================================
+   Block management (internal)
+   ============================================================ */
+
+/* Point the embedded Arena at `block`, with `offset` bytes already used */
+static inline void arena_chain_enter_(ArenaChain* chain, ArenaBlock* block, size_t offset)
+{
+    chain->current = block;
+    chain->arena.buffer = (uint8_t*)block + ARENA_CHAIN_HEADER_SIZE;
+    chain->arena.capacity = block->size - ARENA_CHAIN_HEADER_SIZE;
+    chain->arena.offset = offset;
+}
+
+/*
+   arena_chain_grow_(chain, needed):
+   Links a block with at least `needed` usable bytes.
+   Reuses the first fitting block on the free list before calling the provider.
+*/
+static inline bool arena_chain_grow_(ArenaChain* chain, size_t needed)
+{
+    const size_t header = ARENA_CHAIN_HEADER_SIZE;
+    if (needed > SIZE_MAX - header) return false;
+
+    ArenaBlock** link = &chain->free_list;
+    ArenaBlock* block = NULL;
+    while (*link) {
+        if ((*link)->size - header >= needed) {
+            block = *link;
+            *link = block->next;
+            break;
+        }
+        link = &(*link)->next;
+    }
+
+    if (!block) {
+        size_t size = needed + header;
+        if (size < chain->block_size) size = chain->block_size;
+        block = (ArenaBlock*)chain->block_alloc(size, chain->ctx);
+        if (!block) return false;
+        block->size = size;
+    }
+
+    block->base = chain->current
+        ? chain->current->base + chain->arena.capacity
+        : 0;
+    block->next = chain->current;
+    arena_chain_enter_(chain, block, 0);
+    return true;
+}
+
+/* ============================================================
+   Allocate memory
+   ============================================================ */
+
+/*
+   arena_chain_alloc(chain, size):
+   Allocates `size` bytes, linking a new block if the current one is full.
+   Returns NULL only if the provider fails.
+*/
+static inline void* arena_chain_alloc(ArenaChain* chain, size_t size)
+{
+    if (!chain || size == 0) return NULL;
+    size_t aligned = mem_align(size);
+    if (aligned > arena_remaining(&chain->arena) && !arena_chain_grow_(chain, aligned)) return NULL;
+    return arena_alloc(&chain->arena, size);
+}
+
+/*
+   arena_chain_alloc_aligned(chain, size, alignment):
+   Allocates `size` bytes aligned to `alignment` (power of two).
+   Returns NULL only if the provider fails.
+*/
+static inline void* arena_chain_alloc_aligned(ArenaChain* chain, size_t size, size_t alignment)
+{
+    if (!chain || size == 0) return NULL;
+    if (size > SIZE_MAX - alignment) return NULL;
+    uintptr_t current = (uintptr_t)(chain->arena.buffer + chain->arena.offset);
+    size_t padding = (size_t)(-current & (alignment - 1));
+    /* A fresh block needs at most alignment - 1 bytes of padding */
+    if (size + padding > arena_remaining(&chain->arena) && !arena_chain_grow_(chain, size + alignment)) return NULL;
+    return arena_alloc_aligned(&chain->arena, size, alignment);
+}
+
+/* ============================================================
+   Reset / checkpoint
+   ============================================================ */
+
+/* Create a checkpoint (logical offset across all blocks) */
+static inline ArenaMark arena_chain_mark(const ArenaChain* chain)
+{
+    if (!chain || !chain->current) return 0;
+    return chain->current->base + chain->arena.offset;
+}
+
+/*
+   arena_chain_reset_to(chain, mark):
+   Rolls back to a previous mark. Blocks linked after the mark
+   are moved to the free list; no memory is returned to the provider.
+*/
+static inline void arena_chain_reset_to(ArenaChain* chain, ArenaMark mark)
+{
+    if (!chain || !chain->current) return;
+    if (mark > arena_chain_mark(chain)) return;
+
+    ArenaBlock* block = chain->current;
+    while (block->next && mark < block->base) {
+        ArenaBlock* prev = block->next;
+        block->next = chain->free_list;
+        chain->free_list = block;
+        block = prev;
+    }
+    arena_chain_enter_(chain, block, mark - block->base);
+    ARENA_STAT_(chain->arena.stats.reset_count++);
+}
+
+/* Reset chain to empty (all allocations invalidated, blocks kept) */
+static inline void arena_chain_reset(ArenaChain* chain)
+{
+    arena_chain_reset_to(chain, 0);
+}
+
+/*
+   arena_chain_release(chain):
+   Hands every block (live and free) back through block_free.
+   If block_free is NULL the blocks are simply forgotten.
+   The chain remains initialized and empty.
+*/
+static inline void arena_chain_release(ArenaChain* chain)
+{
+    if (!chain) return;
+    ArenaBlock* lists[2] = { chain->current, chain->free_list };
+    for (int i = 0; i < 2; ++i) {
+        ArenaBlock* block = lists[i];
+        while (block) {
+            ArenaBlock* next = block->next;
+            if (chain->block_free) chain->block_free(block, block->size, chain->ctx);
+            block = next;
+        }
+    }
+    chain->current = NULL;
+    chain->free_list = NULL;
+    chain->arena = (Arena){0};
+}
+
+/* ============================================================
+   Typed allocation macros
+   ============================================================ */
+#define arena_chain_alloc_type(chain, Type) ((Type*)arena_chain_alloc((chain), sizeof(Type)))
+#define arena_chain_alloc_array(chain, Type, count) ((Type*)arena_chain_alloc((chain), sizeof(Type)*(count)))
+
+#endif /* CANON_C_CORE_ARENA_CHAIN_H */
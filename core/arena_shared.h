@@ -0,0 +1,218 @@
+#ifndef CANON_C_CORE_ARENA_SHARED_H
+#define CANON_C_CORE_ARENA_SHARED_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "arena.h"
+
+/*
+    arena_shared.h — Arena shared between threads (lock-free bump)
+
+    ArenaShared:
+      - Same caller-owned buffer model as Arena.
+      - Space is claimed with a single atomic fetch-add; no locks, no CAS loop.
+      - Safe to allocate from any number of threads concurrently.
+
+    ArenaLocal:
+      - Per-thread view that claims a chunk (64 KiB by default) from an
+        ArenaShared and bumps inside it with a plain Arena.
+      - The hot path touches no shared cache line.
+
+    Requires C11 <stdatomic.h>.
+    Reset and rollback are NOT concurrent operations:
+    the caller must ensure no thread is allocating while they run.
+*/
+
+#define ARENA_SHARED_CACHE_LINE  64
+#define ARENA_SHARED_CHUNK_SIZE  ((size_t)64 * 1024)
+
+/* ============================================================
+   Shared arena structure
+   ============================================================ */
+
+/*
+   The atomic offset lives on its own cache line so threads reading
+   buffer/capacity do not contend with threads claiming space.
+*/
+typedef struct ArenaShared {
+    uint8_t* buffer;   /* memory buffer (caller-owned) */
+    size_t capacity;   /* total bytes available */
+    _Alignas(ARENA_SHARED_CACHE_LINE) atomic_size_t offset; /* next free byte */
+} ArenaShared;
+
+/*
+   arena_shared_init(arena, buffer, capacity):
+   Initializes a shared arena over a fixed memory buffer.
+   Must complete before the arena is published to other threads.
+   Preconditions: buffer != NULL, capacity > 0.
+   Ownership: caller owns buffer.
+*/
+static inline void arena_shared_init(ArenaShared* arena, void* buffer, size_t capacity)
+{
+    if (!arena || !buffer || capacity == 0) return;
+    arena->buffer = (uint8_t*)buffer;
+    arena->capacity = capacity;
+    atomic_init(&arena->offset, 0);
+}
+
+/* ============================================================
+   Allocate memory (thread-safe)
+   ============================================================ */
+
+/*
+   arena_alloc_atomic(arena, size):
+   Allocates `size` bytes (rounded up like arena_alloc).
+   Returns NULL if insufficient capacity.
+   A failed claim still advances the offset past capacity,
+   so every later claim fails too; capacity is never exceeded.
+*/
+static inline void* arena_alloc_atomic(ArenaShared* arena, size_t size)
+{
+    if (!arena || size == 0) return NULL;
+    size = mem_align(size);
+    if (size > arena->capacity) return NULL;
+
+    /* Cheap early-out keeps a full arena from pushing offset towards overflow */
+    if (atomic_load_explicit(&arena->offset, memory_order_relaxed) > arena->capacity - size)
+        return NULL;
+
+    size_t start = atomic_fetch_add_explicit(&arena->offset, size, memory_order_relaxed);
+    if (start > arena->capacity - size) return NULL;
+    return arena->buffer + start;
+}
+
+/*
+   arena_alloc_atomic_aligned(arena, size, alignment):
+   Allocates `size` bytes aligned to `alignment` (power of two).
+   Claims size + alignment - 1 bytes in one fetch-add and aligns inside
+   the claimed range, since the padding depends on where the claim lands.
+   Returns NULL if insufficient capacity.
+*/
+static inline void* arena_alloc_atomic_aligned(ArenaShared* arena, size_t size, size_t alignment)
+{
+    if (!arena || size == 0 || alignment == 0) return NULL;
+    if (size > SIZE_MAX - (alignment - 1)) return NULL;
+    size_t claim = size + alignment - 1;
+    if (claim > arena->capacity) return NULL;
+
+    if (atomic_load_explicit(&arena->offset, memory_order_relaxed) > arena->capacity - claim)
+        return NULL;
+
+    size_t start = atomic_fetch_add_explicit(&arena->offset, claim, memory_order_relaxed);
+    if (start > arena->capacity - claim) return NULL;
+
+    uintptr_t current = (uintptr_t)(arena->buffer + start);
+    uintptr_t aligned = (current + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    return (void*)aligned;
+}
+
+/* Remaining capacity in bytes (a snapshot; may be stale immediately) */
+static inline size_t arena_shared_remaining(const ArenaShared* arena)
+{
+    if (!arena) return 0;
+    size_t offset = atomic_load_explicit(&arena->offset, memory_order_relaxed);
+    return offset < arena->capacity ? arena->capacity - offset : 0;
+}
+
+/* ============================================================
+   Reset / checkpoint (NOT thread-safe)
+   ============================================================ */
+
+/* Reset arena to empty (all allocations invalidated) */
+static inline void arena_shared_reset(ArenaShared* arena)
+{
+    if (!arena) return;
+    atomic_store_explicit(&arena->offset, 0, memory_order_relaxed);
+}
+
+/* Create a checkpoint of current offset */
+static inline ArenaMark arena_shared_mark(const ArenaShared* arena)
+{
+    if (!arena) return 0;
+    size_t offset = atomic_load_explicit(&arena->offset, memory_order_relaxed);
+    return offset < arena->capacity ? offset : arena->capacity;
+}
+
+/* Reset arena to a previous mark */
+static inline void arena_shared_reset_to(ArenaShared* arena, ArenaMark mark)
+{
+    if (!arena || mark > arena->capacity) return;
+    atomic_store_explicit(&arena->offset, mark, memory_order_relaxed);
+}
+
+/* ============================================================
+   Per-thread chunked allocation
+   ============================================================ */
+
+/*
+   ArenaLocal is owned by exactly one thread.
+   Allocations up to half a chunk are served from the local chunk;
+   larger ones go straight to the shared arena.
+*/
+typedef struct ArenaLocal {
+    ArenaShared* shared; /* source of chunks */
+    Arena chunk;         /* current chunk, bumped without atomics */
+    size_t chunk_size;   /* bytes claimed per refill */
+} ArenaLocal;
+
+/*
+   arena_local_init(local, shared, chunk_size):
+   Binds a per-thread view to `shared`. chunk_size == 0 selects
+   ARENA_SHARED_CHUNK_SIZE. No memory is claimed until the first allocation.
+*/
+static inline void arena_local_init(ArenaLocal* local, ArenaShared* shared, size_t chunk_size)
+{
+    if (!local || !shared) return;
+    local->shared = shared;
+    local->chunk = (Arena){0};
+    local->chunk_size = chunk_size ? mem_align(chunk_size) : ARENA_SHARED_CHUNK_SIZE;
+}
+
+/*
+   arena_local_alloc(local, size):
+   Allocates `size` bytes. Touches the shared offset only when the
+   current chunk is exhausted. When no full chunk is left, the request
+   is claimed from the shared arena directly.
+   Returns NULL if the shared arena is exhausted.
+*/
+static inline void* arena_local_alloc(ArenaLocal* local, size_t size)
+{
+    if (!local || !local->shared || size == 0) return NULL;
+
+    void* ptr = arena_alloc(&local->chunk, size);
+    if (ptr) return ptr;
+
+    if (mem_align(size) > local->chunk_size / 2) {
+        return arena_alloc_atomic(local->shared, size);
+    }
+
+    /* Chunks start on a cache line so neighbouring threads never share one */
+    void* chunk = arena_alloc_atomic_aligned(local->shared, local->chunk_size, ARENA_SHARED_CACHE_LINE);
+    if (!chunk) return arena_alloc_atomic(local->shared, size);
+
+    arena_init(&local->chunk, chunk, local->chunk_size);
+    return arena_alloc(&local->chunk, size);
+}
+
+/*
+   arena_local_reset(local):
+   Drops the current chunk. Call after the shared arena is reset or
+   rolled back; the unused tail of the chunk is not returned.
+*/
+static inline void arena_local_reset(ArenaLocal* local)
+{
+    if (!local) return;
+    local->chunk = (Arena){0};
+}
+
+/* ============================================================
+   Typed allocation macros
+   ============================================================ */
+#define arena_alloc_atomic_type(arena, Type) ((Type*)arena_alloc_atomic((arena), sizeof(Type)))
+#define arena_alloc_atomic_array(arena, Type, count) ((Type*)arena_alloc_atomic((arena), sizeof(Type)*(count)))
+#define arena_local_alloc_type(local, Type) ((Type*)arena_local_alloc((local), sizeof(Type)))
+#define arena_local_alloc_array(local, Type, count) ((Type*)arena_local_alloc((local), sizeof(Type)*(count)))
+
+#endif /* CANON_C_CORE_ARENA_SHARED_H */
@@ -0,0 +1,286 @@
+#ifndef CANON_C_CORE_ARENA_VM_H
+#define CANON_C_CORE_ARENA_VM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "arena.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/*
+    arena_vm.h — Reserve/commit arena backed by virtual memory
+
+    Reserves a large address range up front and commits pages
+    only as the offset grows:
+      - Allocations never move.
+      - Allocation fails only when the reservation is exhausted.
+      - Resident memory tracks what is actually used.
+
+    Allocation is explicit: the reservation is obtained from the OS
+    in arena_vm_init and returned in arena_vm_destroy.
+
+    POSIX: mmap(PROT_NONE) + mprotect / madvise.
+    Windows: VirtualAlloc(MEM_RESERVE) + MEM_COMMIT / MEM_DECOMMIT.
+    On POSIX, MAP_ANONYMOUS and MADV_* may require _DEFAULT_SOURCE.
+*/
+
+/* ============================================================
+   Arena structure
+   ============================================================ */
+
+/* Flags for arena_vm_init */
+enum {
+    ARENA_VM_DEFAULT    = 0,
+    ARENA_VM_HUGE_PAGES = 1u << 0  /* align to 2 MiB and hint transparent huge pages */
+};
+
+#define ARENA_VM_HUGE_PAGE_SIZE  ((size_t)2 * 1024 * 1024)
+#define ARENA_VM_COMMIT_STEP     ((size_t)64 * 1024)
+
+/*
+   The embedded Arena's capacity is the committed size,
+   so plain arena_alloc on `arena` never touches reserved-only pages.
+*/
+typedef struct ArenaVM {
+    Arena arena;          /* view over committed memory */
+    size_t reserved;      /* total bytes of address space reserved */
+    size_t commit_step;   /* commit granularity (multiple of page size) */
+    void* mapping;        /* start of the OS mapping (for destroy) */
+    size_t mapping_size;  /* size of the OS mapping */
+} ArenaVM;
+
+/* ============================================================
+   Platform layer (internal)
+   ============================================================ */
+
+static inline size_t arena_vm_page_size_(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (size_t)info.dwPageSize;
+#else
+    long page = sysconf(_SC_PAGESIZE);
+    return page > 0 ? (size_t)page : 4096u;
+#endif
+}
+
+static inline void* arena_vm_reserve_(size_t size)
+{
+#ifdef _WIN32
+    return VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_NOACCESS);
+#else
+#if defined(MAP_ANONYMOUS)
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#else
+    int flags = MAP_PRIVATE | MAP_ANON;
+#endif
+#if defined(MAP_NORESERVE)
+    flags |= MAP_NORESERVE;
+#endif
+    void* p = mmap(NULL, size, PROT_NONE, flags, -1, 0);
+    return p == MAP_FAILED ? NULL : p;
+#endif
+}
+
+static inline void arena_vm_unmap_(void* ptr, size_t size)
+{
+#ifdef _WIN32
+    (void)size;
+    VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+    munmap(ptr, size);
+#endif
+}
+
+static inline bool arena_vm_commit_(void* ptr, size_t size)
+{
+#ifdef _WIN32
+    return VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE) != NULL;
+#else
+    return mprotect(ptr, size, PROT_READ | PROT_WRITE) == 0;
+#endif
+}
+
+/* Returns pages to the OS and makes them inaccessible again */
+static inline void arena_vm_decommit_(void* ptr, size_t size)
+{
+#ifdef _WIN32
+    VirtualFree(ptr, size, MEM_DECOMMIT);
+#else
+    madvise(ptr, size, MADV_DONTNEED);
+    mprotect(ptr, size, PROT_NONE);
+#endif
+}
+
+/* ============================================================
+   Initialize / destroy
+   ============================================================ */
+
+/*
+   arena_vm_init(vm, reserve_size, flags):
+   Reserves `reserve_size` bytes of address space (rounded up to pages).
+   Nothing is committed until the first allocation.
+   With ARENA_VM_HUGE_PAGES the range is 2 MiB aligned, committed in
+   2 MiB steps and marked MADV_HUGEPAGE where available.
+   Returns false if the OS refuses the reservation.
+   Ownership: caller must call arena_vm_destroy.
+*/
+static inline bool arena_vm_init(ArenaVM* vm, size_t reserve_size, unsigned flags)
+{
+    if (!vm || reserve_size == 0) return false;
+
+    const size_t page = arena_vm_page_size_();
+    const bool huge = (flags & ARENA_VM_HUGE_PAGES) != 0;
+    const size_t align = huge ? ARENA_VM_HUGE_PAGE_SIZE : page;
+
+    size_t size = mem_align_to(reserve_size, align);
+    if (size == SIZE_MAX) return false;
+
+    /* Over-reserve so the usable range can start on a huge-page boundary */
+    size_t mapping_size = huge ? size + align : size;
+    if (mapping_size < size) return false;
+
+    void* mapping = arena_vm_reserve_(mapping_size);
+    if (!mapping) return false;
+
+    uintptr_t start = ((uintptr_t)mapping + align - 1) & ~(uintptr_t)(align - 1);
+
+#if !defined(_WIN32) && defined(MADV_HUGEPAGE)
+    if (huge) madvise((void*)start, size, MADV_HUGEPAGE);
+#endif
+
+    *vm = (ArenaVM){
+        .arena = { .buffer = (uint8_t*)start, .capacity = 0, .offset = 0 },
+        .reserved = size,
+        .commit_step = huge ? ARENA_VM_HUGE_PAGE_SIZE : mem_align_to(ARENA_VM_COMMIT_STEP, page),
+        .mapping = mapping,
+        .mapping_size = mapping_size
+    };
+    return true;
+}
+
+/* Release the whole reservation (all allocations invalidated) */
+static inline void arena_vm_destroy(ArenaVM* vm)
+{
+    if (!vm || !vm->mapping) return;
+    arena_vm_unmap_(vm->mapping, vm->mapping_size);
+    *vm = (ArenaVM){0};
+}
+
+/* ============================================================
+   Commit (internal)
+   ============================================================ */
+
+/* Ensure at least `needed` bytes from the start are committed */
+static inline bool arena_vm_ensure_(ArenaVM* vm, size_t needed)
+{
+    if (needed <= vm->arena.capacity) return true;
+    if (needed > vm->reserved) return false;
+
+    size_t target = mem_align_to(needed, vm->commit_step);
+    if (target > vm->reserved) target = vm->reserved;
+
+    size_t committed = vm->arena.capacity;
+    if (!arena_vm_commit_(vm->arena.buffer + committed, target - committed)) return false;
+    vm->arena.capacity = target;
+    return true;
+}
+
+/* ============================================================
+   Allocate memory
+   ============================================================ */
+
+/*
+   arena_vm_alloc(vm, size):
+   Allocates `size` bytes, committing pages as needed.
+   Returns NULL if the reservation is exhausted or commit fails.
+*/
+static inline void* arena_vm_alloc(ArenaVM* vm, size_t size)
+{
+    if (!vm || size == 0) return NULL;
+    size_t aligned = mem_align(size);
+    if (aligned <= vm->reserved - vm->arena.offset) {
+        arena_vm_ensure_(vm, vm->arena.offset + aligned);
+    }
+    return arena_alloc(&vm->arena, size);
+}
+
+/*
+   arena_vm_alloc_aligned(vm, size, alignment):
+   Allocates `size` bytes aligned to `alignment` (power of two).
+   Returns NULL if the reservation is exhausted or commit fails.
+*/
+static inline void* arena_vm_alloc_aligned(ArenaVM* vm, size_t size, size_t alignment)
+{
+    if (!vm || size == 0 || size > SIZE_MAX - alignment) return NULL;
+    uintptr_t current = (uintptr_t)(vm->arena.buffer + vm->arena.offset);
+    size_t needed = size + (size_t)(-current & (alignment - 1));
+    if (needed <= vm->reserved - vm->arena.offset) {
+        arena_vm_ensure_(vm, vm->arena.offset + needed);
+    }
+    return arena_alloc_aligned(&vm->arena, size, alignment);
+}
+
+/* ============================================================
+   Reset / checkpoint
+   ============================================================ */
+
+/* Create a checkpoint of current offset */
+static inline ArenaMark arena_vm_mark(const ArenaVM* vm)
+{
+    return vm ? vm->arena.offset : 0;
+}
+
+/*
+   arena_vm_reset_to(vm, mark, release_tail):
+   Rolls back to a previous mark.
+   If release_tail is true, committed pages past the mark
+   (rounded up to the commit step) are returned to the OS,
+   so a one-off spike does not stay resident.
+*/
+static inline void arena_vm_reset_to(ArenaVM* vm, ArenaMark mark, bool release_tail)
+{
+    if (!vm || mark > vm->arena.offset) return;
+    arena_reset_to(&vm->arena, mark);
+    if (!release_tail) return;
+
+    size_t keep = mem_align_to(mark, vm->commit_step);
+    if (keep > vm->reserved) keep = vm->reserved;
+    if (keep >= vm->arena.capacity) return;
+
+    arena_vm_decommit_(vm->arena.buffer + keep, vm->arena.capacity - keep);
+    vm->arena.capacity = keep;
+}
+
+/* Reset to empty; optionally return committed pages to the OS */
+static inline void arena_vm_reset(ArenaVM* vm, bool release_tail)
+{
+    arena_vm_reset_to(vm, 0, release_tail);
+}
+
+/* Bytes currently committed (upper bound on resident memory) */
+static inline size_t arena_vm_committed(const ArenaVM* vm)
+{
+    return vm ? vm->arena.capacity : 0;
+}
+
+/* Bytes left before the reservation is exhausted */
+static inline size_t arena_vm_remaining(const ArenaVM* vm)
+{
+    return vm ? vm->reserved - vm->arena.offset : 0;
+}
+
+/* ============================================================
+   Typed allocation macros
+   ============================================================ */
+#define arena_vm_alloc_type(vm, Type) ((Type*)arena_vm_alloc((vm), sizeof(Type)))
+#define arena_vm_alloc_array(vm, Type, count) ((Type*)arena_vm_alloc((vm), sizeof(Type)*(count)))
+
+#endif /* CANON_C_CORE_ARENA_VM_H */
@@ -0,0 +1,50 @@
+#ifndef CANON_C_CORE_CPU_H
+#define CANON_C_CORE_CPU_H
+
+#include <stdbool.h>
+
+/*
+    cpu.h — Runtime CPU feature detection for SIMD dispatch
+
+    Kernels that use wide vector instructions are compiled per ISA with
+    CANON_C_TARGET(...) and selected at run time with cpu_features().
+    Nothing is cached: every query asks the compiler runtime, which reads
+    flags filled in once at program start. No global state of our own.
+
+    Supported: x86-64 with GCC or Clang. Everywhere else all features
+    report false and callers take their portable scalar path.
+*/
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CANON_C_X86_SIMD 1
+#define CANON_C_TARGET(isa) __attribute__((target(isa)))
+#include <immintrin.h>
+#else
+#define CANON_C_X86_SIMD 0
+#define CANON_C_TARGET(isa)
+#endif
+
+typedef struct {
+    bool sse2;
+    bool sse41;
+    bool avx2;
+    bool avx512f;
+    bool avx512bw;  /* byte/word AVX-512 (needed for 8/16-bit kernels) */
+} CpuFeatures;
+
+/* Query the running CPU (and OS support for its register state) */
+static inline CpuFeatures cpu_features(void)
+{
+    CpuFeatures f = {0};
+#if CANON_C_X86_SIMD
+    __builtin_cpu_init();
+    f.sse2     = __builtin_cpu_supports("sse2");
+    f.sse41    = __builtin_cpu_supports("sse4.1");
+    f.avx2     = __builtin_cpu_supports("avx2");
+    f.avx512f  = __builtin_cpu_supports("avx512f");
+    f.avx512bw = __builtin_cpu_supports("avx512bw");
+#endif
+    return f;
+}
+
+#endif /* CANON_C_CORE_CPU_H */
@@ -0,0 +1,154 @@
+#ifndef CANON_C_CORE_HANDLE_POOL_H
+#define CANON_C_CORE_HANDLE_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "arena.h"
+
+/*
+    handle_pool.h — Generational handle pool with dense storage
+
+    Objects are referenced by Handle (32-bit slot index + 32-bit generation)
+    instead of raw pointers:
+      - A removed object's handle stops resolving (generation mismatch).
+      - Live objects are packed contiguously; iteration is a plain array walk.
+      - Insert and remove are O(1); remove swaps the last object into the hole,
+        so dense order is not stable across removals.
+
+    Storage is carved from a caller-owned Arena at init. No resizing.
+*/
+
+typedef struct {
+    uint32_t index;       /* slot index */
+    uint32_t generation;  /* must match the slot's current generation */
+} Handle;
+
+/* Generations start at 1, so a zeroed Handle never resolves */
+#define HANDLE_NULL ((Handle){ .index = 0, .generation = 0 })
+
+static inline bool handle_is_null(Handle h) { return h.generation == 0; }
+static inline bool handle_equal(Handle a, Handle b) { return a.index == b.index && a.generation == b.generation; }
+
+/* Sparse slot: either points into dense storage or links the free list */
+typedef struct {
+    uint32_t dense_or_next;  /* dense index when live, next free slot when free */
+    uint32_t generation;
+} HandleSlot;
+
+#define HANDLE_POOL_NO_SLOT UINT32_MAX
+
+#define DEFINE_HANDLE_POOL(Type) \
+typedef struct { \
+    Type* items;          /* dense live objects [0, len) */ \
+    uint32_t* owners;     /* owners[i] = slot of items[i] */ \
+    HandleSlot* slots;    /* sparse slot table */ \
+    uint32_t len;         /* live objects */ \
+    uint32_t capacity;    /* max live objects */ \
+    uint32_t slots_used;  /* slots ever handed out */ \
+    uint32_t free_head;   /* first free slot, or HANDLE_POOL_NO_SLOT */ \
+} handle_pool_##Type; \
+\
+/* Carve storage for `capacity` objects from arena; false if it does not fit */ \
+static inline bool handle_pool_##Type##_init(handle_pool_##Type* p, Arena* arena, size_t capacity) \
+{ \
+    if (!p || !arena || capacity == 0 || capacity >= HANDLE_POOL_NO_SLOT) return false; \
+    ArenaMark mark = arena_mark(arena); \
+    Type* items = arena_alloc_array(arena, Type, capacity); \
+    uint32_t* owners = arena_alloc_array(arena, uint32_t, capacity); \
+    HandleSlot* slots = arena_alloc_array(arena, HandleSlot, capacity); \
+    if (!items || !owners || !slots) { \
+        arena_reset_to(arena, mark); \
+        return false; \
+    } \
+    *p = (handle_pool_##Type){ .items = items, .owners = owners, .slots = slots, \
+                               .len = 0, .capacity = (uint32_t)capacity, \
+                               .slots_used = 0, .free_head = HANDLE_POOL_NO_SLOT }; \
+    return true; \
+} \
+\
+static inline size_t handle_pool_##Type##_len(const handle_pool_##Type* p) { return p ? p->len : 0; } \
+static inline bool handle_pool_##Type##_is_full(const handle_pool_##Type* p) { return p && p->len >= p->capacity; } \
+\
+/* Insert a copy of item; returns HANDLE_NULL when full */ \
+static inline Handle handle_pool_##Type##_insert(handle_pool_##Type* p, Type item) \
+{ \
+    if (!p || p->len >= p->capacity) return HANDLE_NULL; \
+    uint32_t slot; \
+    if (p->free_head != HANDLE_POOL_NO_SLOT) { \
+        slot = p->free_head; \
+        p->free_head = p->slots[slot].dense_or_next; \
+    } else { \
+        slot = p->slots_used++; \
+        p->slots[slot].generation = 1; \
+    } \
+    uint32_t dense = p->len++; \
+    p->items[dense] = item; \
+    p->owners[dense] = slot; \
+    p->slots[slot].dense_or_next = dense; \
+    return (Handle){ .index = slot, .generation = p->slots[slot].generation }; \
+} \
+\
+/* True if h refers to a live object */ \
+static inline bool handle_pool_##Type##_contains(const handle_pool_##Type* p, Handle h) \
+{ \
+    return p && h.index < p->slots_used && h.generation != 0 \
+        && p->slots[h.index].generation == h.generation; \
+} \
+\
+/* Borrowed pointer to the object, or NULL if h is stale. \
+   Invalidated by the next insert or remove. */ \
+static inline Type* handle_pool_##Type##_get_ptr(handle_pool_##Type* p, Handle h) \
+{ \
+    if (!handle_pool_##Type##_contains(p, h)) return NULL; \
+    return &p->items[p->slots[h.index].dense_or_next]; \
+} \
+\
+/* Copy the object to out; false if h is stale */ \
+static inline bool handle_pool_##Type##_get(const handle_pool_##Type* p, Handle h, Type* out) \
+{ \
+    if (!out || !handle_pool_##Type##_contains(p, h)) return false; \
+    *out = p->items[p->slots[h.index].dense_or_next]; \
+    return true; \
+} \
+\
+/* Remove the object (swap-remove); false if h is stale */ \
+static inline bool handle_pool_##Type##_remove(handle_pool_##Type* p, Handle h) \
+{ \
+    if (!handle_pool_##Type##_contains(p, h)) return false; \
+    HandleSlot* slot = &p->slots[h.index]; \
+    uint32_t hole = slot->dense_or_next; \
+    uint32_t last = --p->len; \
+    if (hole != last) { \
+        p->items[hole] = p->items[last]; \
+        p->owners[hole] = p->owners[last]; \
+        p->slots[p->owners[hole]].dense_or_next = hole; \
+    } \
+    slot->generation = (slot->generation == UINT32_MAX) ? 1 : slot->generation + 1; \
+    slot->dense_or_next = p->free_head; \
+    p->free_head = h.index; \
+    return true; \
+} \
+\
+/* Handle of the object at dense position i (for use while iterating) */ \
+static inline Handle handle_pool_##Type##_handle_at(const handle_pool_##Type* p, size_t i) \
+{ \
+    if (!p || i >= p->len) return HANDLE_NULL; \
+    uint32_t slot = p->owners[i]; \
+    return (Handle){ .index = slot, .generation = p->slots[slot].generation }; \
+} \
+\
+/* Remove everything; all outstanding handles become stale */ \
+static inline void handle_pool_##Type##_clear(handle_pool_##Type* p) \
+{ \
+    if (!p) return; \
+    while (p->len > 0) { \
+        handle_pool_##Type##_remove(p, handle_pool_##Type##_handle_at(p, p->len - 1)); \
+    } \
+}
+
+/* Iterate live objects: HANDLE_POOL_FOR(pool, Type, it) { it->... } */
+#define HANDLE_POOL_FOR(pool, Type, it) \
+    for (Type* it = (pool).items; it < (pool).items + (pool).len; ++it)
+
+#endif /* CANON_C_CORE_HANDLE_POOL_H */
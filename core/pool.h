@@ -3,6 +3,7 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+#include <assert.h>
 #include "arena.h"
 
 /*
@@ -10,18 +11,65 @@
 
     Fast, deterministic allocation for objects of one size.
     Backed by Arena (linear bump within fixed buffer).
-    No individual frees — only full reset.
+    Freed objects go on an intrusive free list threaded through
+    the freed slots and are reused before the arena is bumped again.
+    pool_reset still reclaims everything at once.
 
     Ideal for nodes, temporary objects, etc.
+
+    Debug mode (CANON_C_POOL_DEBUG, on unless NDEBUG is defined):
+    pool_free detects double frees, asserts, and ignores them.
+    Release builds carry no extra cost.
+
+    Statistics (CANON_C_MEM_STATS, off by default):
+    same opt-in switch as Arena; see pool_stats.
 */
 
+#ifndef CANON_C_POOL_DEBUG
+#  ifdef NDEBUG
+#    define CANON_C_POOL_DEBUG 0
+#  else
+#    define CANON_C_POOL_DEBUG 1
+#  endif
+#endif
+
+/* Written into freed slots in debug mode to flag them cheaply */
+#define POOL_FREED_MAGIC ((uintptr_t)0xDEADF7EEu)
+
+/* Link stored in the first bytes of every freed slot */
+typedef struct PoolFreeNode {
+    struct PoolFreeNode* next;
+    uintptr_t magic;  /* debug mode only; present when the slot is large enough */
+} PoolFreeNode;
+
+/* Allocation history, recorded only when CANON_C_MEM_STATS is defined */
+typedef struct PoolStats {
+    size_t peak_used;    // highest simultaneous object count
+    size_t alloc_count;  // successful allocations
+    size_t free_count;   // successful frees
+    size_t failed_count; // allocations refused (pool or arena full)
+    size_t reset_count;  // pool_reset calls
+} PoolStats;
+
 typedef struct {
     Arena* arena;       // backing arena (caller-owned)
     size_t object_size; // aligned size of each object
     size_t capacity;    // max objects
     size_t used;        // objects currently allocated
+    size_t carved;      // objects ever bumped from the arena since reset
+    PoolFreeNode* free_list; // freed slots awaiting reuse
+#ifdef CANON_C_MEM_STATS
+    PoolStats stats;    // allocation history
+#endif
 } Pool;
 
+/* Record a successful allocation */
+#define POOL_STAT_ALLOC_(pool) \
+    ARENA_STAT_( \
+        (pool)->stats.alloc_count++; \
+        if ((pool)->used > (pool)->stats.peak_used) (pool)->stats.peak_used = (pool)->used \
+    )
+
 /* Initialize pool with pre-allocated arena buffer */
 static inline bool pool_init(Pool* pool, Arena* arena, size_t object_size, size_t max_objects)
 {
@@ -36,6 +84,9 @@ static inline bool pool_init(Pool* pool, Arena* arena, size_t object_size, size_
     pool->object_size = aligned_size;
     pool->capacity = max_objects;
     pool->used = 0;
+    pool->carved = 0;
+    pool->free_list = NULL;
+    ARENA_STAT_(pool->stats = (PoolStats){0});
 
     return true;
 }
@@ -43,13 +94,68 @@ static inline bool pool_init(Pool* pool, Arena* arena, size_t object_size, size_
 /* Allocate one object — returns aligned pointer or NULL */
 static inline void* pool_alloc(Pool* pool)
 {
-    if (!pool || pool->used >= pool->capacity) return NULL;
+    if (!pool) return NULL;
+
+    PoolFreeNode* node = pool->free_list;
+    if (node) {
+        pool->free_list = node->next;
+#if CANON_C_POOL_DEBUG
+        if (pool->object_size >= sizeof(PoolFreeNode)) node->magic = 0;
+#endif
+        pool->used++;
+        POOL_STAT_ALLOC_(pool);
+        return node;
+    }
 
-    void* ptr = arena_alloc(pool->arena, pool->object_size);
-    if (ptr) pool->used++;
+    void* ptr = pool->carved < pool->capacity ? arena_alloc(pool->arena, pool->object_size) : NULL;
+    if (!ptr) {
+        ARENA_STAT_(pool->stats.failed_count++);
+        return NULL;
+    }
+    pool->carved++;
+    pool->used++;
+    POOL_STAT_ALLOC_(pool);
     return ptr;
 }
 
+#if CANON_C_POOL_DEBUG
+/* Debug only: true if `ptr` is already on the free list */
+static inline bool pool_debug_is_free_(const Pool* pool, const PoolFreeNode* ptr)
+{
+    /* Magic check first so live objects are rejected without a list walk */
+    if (pool->object_size >= sizeof(PoolFreeNode) && ptr->magic != POOL_FREED_MAGIC) return false;
+    for (const PoolFreeNode* n = pool->free_list; n; n = n->next) {
+        if (n == ptr) return true;
+    }
+    return false;
+}
+#endif
+
+/*
+   pool_free(pool, ptr):
+   Returns one object to the pool in O(1). `ptr` must come from pool_alloc
+   on the same pool and must not be used afterwards.
+   Returns false on invalid input, or on a detected double free (debug mode).
+*/
+static inline bool pool_free(Pool* pool, void* ptr)
+{
+    if (!pool || !ptr || pool->used == 0) return false;
+
+    PoolFreeNode* node = (PoolFreeNode*)ptr;
+#if CANON_C_POOL_DEBUG
+    if (pool_debug_is_free_(pool, node)) {
+        assert(!"pool_free: double free");
+        return false;
+    }
+    if (pool->object_size >= sizeof(PoolFreeNode)) node->magic = POOL_FREED_MAGIC;
+#endif
+    node->next = pool->free_list;
+    pool->free_list = node;
+    pool->used--;
+    ARENA_STAT_(pool->stats.free_count++);
+    return true;
+}
+
 /* Current usage */
 static inline size_t pool_used(const Pool* pool) { return pool ? pool->used : 0; }
 static inline size_t pool_capacity(const Pool* pool) { return pool ? pool->capacity : 0; }
@@ -60,8 +166,30 @@ static inline void pool_reset(Pool* pool)
 {
     if (!pool || !pool->arena) return;
     ArenaMark mark = arena_mark(pool->arena);
-    arena_reset_to(pool->arena, mark - pool->object_size * pool->used);
+    arena_reset_to(pool->arena, mark - pool->object_size * pool->carved);
     pool->used = 0;
+    pool->carved = 0;
+    pool->free_list = NULL;
+    ARENA_STAT_(pool->stats.reset_count++);
+}
+
+/*
+   pool_stats(pool, out):
+   Copies the pool's statistics to out.
+   Returns false (and zeroes out) when CANON_C_MEM_STATS is not defined.
+*/
+static inline bool pool_stats(const Pool* pool, PoolStats* out)
+{
+    if (!out) return false;
+    *out = (PoolStats){0};
+#ifdef CANON_C_MEM_STATS
+    if (!pool) return false;
+    *out = pool->stats;
+    return true;
+#else
+    (void)pool;
+    return false;
+#endif
 }
 
 #endif /* CANON_C_CORE_POOL_H */
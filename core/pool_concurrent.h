@@ -0,0 +1,220 @@
+#ifndef CANON_C_CORE_POOL_CONCURRENT_H
+#define CANON_C_CORE_POOL_CONCURRENT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "arena.h"
+
+/*
+    pool_concurrent.h — Fixed-size object pool shared between threads
+
+    Objects may be allocated on one thread and freed on another.
+
+    PoolConcurrent:
+      - All slots are carved from the backing Arena once, at init.
+      - Freed objects travel in batches on a lock-free Treiber stack.
+      - The stack head packs a 32-bit slot index with a 32-bit generation
+        tag, so a stale compare-and-swap cannot succeed (ABA protection).
+
+    PoolMagazine:
+      - Per-thread cache of free objects (owned by exactly one thread).
+      - Alloc and free hit only the magazine; the shared stack is touched
+        once per batch, when the magazine runs empty or overflows.
+
+    Requires C11 <stdatomic.h> and lock-free 64-bit atomics.
+*/
+
+#define POOL_CONCURRENT_CACHE_LINE 64
+#define POOL_MAGAZINE_SIZE         32   /* objects cached per thread */
+#define POOL_MAGAZINE_BATCH        16   /* objects moved per refill/flush */
+
+/* ============================================================
+   Pool structure
+   ============================================================ */
+
+/* Layout of a free slot: links within a batch and between batches */
+typedef struct PoolBatchLink {
+    uint32_t next;               /* next slot in this batch (index + 1, 0 = end) */
+    _Atomic uint32_t next_batch; /* next batch on the shared stack (index + 1) */
+} PoolBatchLink;
+
+typedef struct PoolConcurrent {
+    uint8_t* slots;      /* contiguous slot storage (from backing arena) */
+    size_t object_size;  /* aligned size of each object */
+    uint32_t capacity;   /* max objects */
+    _Alignas(POOL_CONCURRENT_CACHE_LINE) atomic_size_t carved;   /* slots handed out fresh */
+    _Alignas(POOL_CONCURRENT_CACHE_LINE) _Atomic uint64_t batches; /* tag << 32 | (head index + 1) */
+} PoolConcurrent;
+
+/*
+   pool_concurrent_init(pool, arena, object_size, max_objects):
+   Carves max_objects slots from `arena` up front.
+   Must complete before the pool is published to other threads.
+   Returns false on invalid input or insufficient arena space.
+*/
+static inline bool pool_concurrent_init(PoolConcurrent* pool, Arena* arena, size_t object_size, size_t max_objects)
+{
+    if (!pool || !arena || object_size == 0 || max_objects == 0) return false;
+    if (max_objects >= UINT32_MAX) return false;
+
+    size_t aligned_size = mem_align(object_size);
+    if (max_objects > SIZE_MAX / aligned_size) return false;
+
+    uint8_t* slots = (uint8_t*)arena_alloc(arena, aligned_size * max_objects);
+    if (!slots) return false;
+
+    pool->slots = slots;
+    pool->object_size = aligned_size;
+    pool->capacity = (uint32_t)max_objects;
+    atomic_init(&pool->carved, 0);
+    atomic_init(&pool->batches, 0);
+    return true;
+}
+
+static inline size_t pool_concurrent_capacity(const PoolConcurrent* pool) { return pool ? pool->capacity : 0; }
+
+/* ============================================================
+   Shared batch stack (internal)
+   ============================================================ */
+
+static inline PoolBatchLink* pool_concurrent_link_(const PoolConcurrent* pool, uint32_t index)
+{
+    return (PoolBatchLink*)(pool->slots + (size_t)index * pool->object_size);
+}
+
+static inline uint32_t pool_concurrent_index_(const PoolConcurrent* pool, const void* ptr)
+{
+    return (uint32_t)(((const uint8_t*)ptr - pool->slots) / pool->object_size);
+}
+
+/* Push a batch whose slots are already chained through `next` */
+static inline void pool_concurrent_push_batch_(PoolConcurrent* pool, uint32_t head)
+{
+    PoolBatchLink* link = pool_concurrent_link_(pool, head);
+    uint64_t old = atomic_load_explicit(&pool->batches, memory_order_relaxed);
+    uint64_t desired;
+    do {
+        atomic_store_explicit(&link->next_batch, (uint32_t)old, memory_order_relaxed);
+        desired = (((old >> 32) + 1) << 32) | (uint64_t)(head + 1);
+    } while (!atomic_compare_exchange_weak_explicit(
+                 &pool->batches, &old, desired,
+                 memory_order_release, memory_order_relaxed));
+}
+
+/* Pop one batch; returns head index + 1, or 0 if the stack is empty */
+static inline uint32_t pool_concurrent_pop_batch_(PoolConcurrent* pool)
+{
+    uint64_t old = atomic_load_explicit(&pool->batches, memory_order_acquire);
+    uint64_t desired;
+    uint32_t head;
+    do {
+        head = (uint32_t)old;
+        if (head == 0) return 0;
+        /* Slot memory is never unmapped, so reading a stale link is harmless;
+           the tag makes the CAS fail if the head changed meanwhile. */
+        uint32_t next = atomic_load_explicit(&pool_concurrent_link_(pool, head - 1)->next_batch,
+                                             memory_order_relaxed);
+        desired = (((old >> 32) + 1) << 32) | (uint64_t)next;
+    } while (!atomic_compare_exchange_weak_explicit(
+                 &pool->batches, &old, desired,
+                 memory_order_acquire, memory_order_acquire));
+    return head;
+}
+
+/* ============================================================
+   Per-thread magazine
+   ============================================================ */
+
+typedef struct PoolMagazine {
+    PoolConcurrent* pool;
+    size_t count;
+    void* items[POOL_MAGAZINE_SIZE];
+} PoolMagazine;
+
+/* Bind an empty magazine to `pool` (one magazine per thread) */
+static inline void pool_magazine_init(PoolMagazine* mag, PoolConcurrent* pool)
+{
+    if (!mag) return;
+    mag->pool = pool;
+    mag->count = 0;
+}
+
+/* Refill an empty magazine: a freed batch first, then fresh slots */
+static inline bool pool_magazine_refill_(PoolMagazine* mag)
+{
+    PoolConcurrent* pool = mag->pool;
+
+    uint32_t head = pool_concurrent_pop_batch_(pool);
+    while (head != 0) {
+        PoolBatchLink* link = pool_concurrent_link_(pool, head - 1);
+        mag->items[mag->count++] = link;
+        head = link->next;
+    }
+    if (mag->count > 0) return true;
+
+    if (atomic_load_explicit(&pool->carved, memory_order_relaxed) >= pool->capacity) return false;
+    size_t start = atomic_fetch_add_explicit(&pool->carved, POOL_MAGAZINE_BATCH, memory_order_relaxed);
+    if (start >= pool->capacity) return false;
+
+    size_t end = start + POOL_MAGAZINE_BATCH;
+    if (end > pool->capacity) end = pool->capacity;
+    for (size_t i = end; i > start; --i) {
+        mag->items[mag->count++] = pool->slots + (i - 1) * pool->object_size;
+    }
+    return true;
+}
+
+/* Move the top `n` cached objects to the shared stack as one batch */
+static inline void pool_magazine_flush_(PoolMagazine* mag, size_t n)
+{
+    if (n == 0) return;
+    PoolConcurrent* pool = mag->pool;
+
+    uint32_t next = 0;
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t index = pool_concurrent_index_(pool, mag->items[--mag->count]);
+        pool_concurrent_link_(pool, index)->next = next;
+        next = index + 1;
+    }
+    pool_concurrent_push_batch_(pool, next - 1);
+}
+
+/*
+   pool_magazine_alloc(mag):
+   Returns one object, or NULL when the pool is exhausted.
+   Touches shared state only when the magazine is empty.
+*/
+static inline void* pool_magazine_alloc(PoolMagazine* mag)
+{
+    if (!mag || !mag->pool) return NULL;
+    if (mag->count == 0 && !pool_magazine_refill_(mag)) return NULL;
+    return mag->items[--mag->count];
+}
+
+/*
+   pool_magazine_free(mag, ptr):
+   Returns an object from the same pool, possibly allocated by another
+   thread. Touches shared state only when the magazine overflows.
+*/
+static inline bool pool_magazine_free(PoolMagazine* mag, void* ptr)
+{
+    if (!mag || !mag->pool || !ptr) return false;
+    if (mag->count == POOL_MAGAZINE_SIZE) pool_magazine_flush_(mag, POOL_MAGAZINE_BATCH);
+    mag->items[mag->count++] = ptr;
+    return true;
+}
+
+/*
+   pool_magazine_flush(mag):
+   Hands every cached object back to the shared pool.
+   Call before the owning thread exits or stops using the pool.
+*/
+static inline void pool_magazine_flush(PoolMagazine* mag)
+{
+    if (!mag || !mag->pool) return;
+    pool_magazine_flush_(mag, mag->count);
+}
+
+#endif /* CANON_C_CORE_POOL_CONCURRENT_H */
@@ -0,0 +1,199 @@
+#ifndef CANON_C_CORE_SLAB_H
+#define CANON_C_CORE_SLAB_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "arena.h"
+#include "pool.h"
+
+/*
+    slab.h — Size-class allocator (one Pool per class, one backing Arena)
+
+    Small objects of mixed sizes are routed to the smallest class that
+    fits. Each class is a Pool, so frees are O(1) and slots are reused.
+    All classes carve from the same caller-owned Arena.
+
+    Routing is a table lookup on the request size; free takes the size
+    of the original request (no per-object headers).
+
+    Per-class statistics expose occupancy and fragmentation so the
+    class table can be tuned against real traffic.
+*/
+
+#define SLAB_MAX_CLASSES     16
+#define SLAB_GRANULE         16    /* routing resolution in bytes */
+#define SLAB_MAX_OBJECT_SIZE 512   /* largest size a class may serve */
+
+/* One entry of the caller's class table */
+typedef struct {
+    size_t size;         /* largest request served by this class */
+    size_t max_objects;  /* slots reserved for this class */
+} SlabClass;
+
+typedef struct {
+    Arena* arena;                        /* backing arena (caller-owned) */
+    ArenaMark base;                      /* arena offset before the first class slot */
+    size_t class_count;
+    Pool pools[SLAB_MAX_CLASSES];        /* one pool per class */
+    size_t class_size[SLAB_MAX_CLASSES]; /* requested class sizes */
+    size_t requested[SLAB_MAX_CLASSES];  /* bytes requested by live objects */
+    size_t failed[SLAB_MAX_CLASSES];     /* allocations refused because the class was full */
+    uint8_t route[SLAB_MAX_OBJECT_SIZE / SLAB_GRANULE]; /* (size - 1) / granule -> class */
+} Slab;
+
+/* ============================================================
+   Initialize
+   ============================================================ */
+
+/*
+   slab_init(slab, arena, classes, count):
+   Builds size classes from `classes` (strictly ascending sizes,
+   each <= SLAB_MAX_OBJECT_SIZE, count <= SLAB_MAX_CLASSES).
+   Fails if the arena cannot hold every class at full capacity.
+   Ownership: caller owns arena; slab memory lives until arena reset.
+*/
+static inline bool slab_init(Slab* slab, Arena* arena, const SlabClass* classes, size_t count)
+{
+    if (!slab || !arena || !classes || count == 0 || count > SLAB_MAX_CLASSES) return false;
+
+    size_t needed = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (classes[i].size == 0 || classes[i].size > SLAB_MAX_OBJECT_SIZE) return false;
+        if (i > 0 && classes[i].size <= classes[i - 1].size) return false;
+        if (classes[i].max_objects == 0) return false;
+        size_t bytes = mem_align(classes[i].size) * classes[i].max_objects;
+        if (bytes / classes[i].max_objects != mem_align(classes[i].size)) return false;
+        if (bytes > SIZE_MAX - needed) return false;
+        needed += bytes;
+    }
+    if (needed > arena_remaining(arena)) return false;
+
+    *slab = (Slab){ .arena = arena, .base = arena_mark(arena), .class_count = count };
+
+    size_t cls = 0;
+    for (size_t slot = 0; slot < SLAB_MAX_OBJECT_SIZE / SLAB_GRANULE; ++slot) {
+        size_t size = slot * SLAB_GRANULE + 1;  /* smallest request in this granule */
+        while (cls < count && classes[cls].size < size) ++cls;
+        slab->route[slot] = (uint8_t)cls;  /* cls == count: no class is large enough */
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        slab->class_size[i] = classes[i].size;
+        if (!pool_init(&slab->pools[i], arena, classes[i].size, classes[i].max_objects)) return false;
+    }
+    return true;
+}
+
+/* ============================================================
+   Routing
+   ============================================================ */
+
+/*
+   slab_class_of(slab, size):
+   Index of the class serving `size`, or class_count if none fits.
+   The route table maps each granule to the first class that can serve
+   its smallest size; classes finer than the granule are stepped over.
+*/
+static inline size_t slab_class_of(const Slab* slab, size_t size)
+{
+    if (!slab || size == 0 || size > SLAB_MAX_OBJECT_SIZE) return slab ? slab->class_count : 0;
+    size_t cls = slab->route[(size - 1) / SLAB_GRANULE];
+    while (cls < slab->class_count && slab->class_size[cls] < size) ++cls;
+    return cls;
+}
+
+/* ============================================================
+   Allocate / free
+   ============================================================ */
+
+/*
+   slab_alloc(slab, size):
+   Allocates from the smallest class that fits `size`.
+   Returns NULL if no class fits or that class is full.
+*/
+static inline void* slab_alloc(Slab* slab, size_t size)
+{
+    size_t cls = slab_class_of(slab, size);
+    if (!slab || cls >= slab->class_count) return NULL;
+
+    void* ptr = pool_alloc(&slab->pools[cls]);
+    if (!ptr) {
+        slab->failed[cls]++;
+        return NULL;
+    }
+    slab->requested[cls] += size;
+    return ptr;
+}
+
+/*
+   slab_free(slab, ptr, size):
+   Returns `ptr` to its class. `size` must equal the size passed to
+   slab_alloc for this object.
+*/
+static inline bool slab_free(Slab* slab, void* ptr, size_t size)
+{
+    size_t cls = slab_class_of(slab, size);
+    if (!slab || !ptr || cls >= slab->class_count) return false;
+    if (!pool_free(&slab->pools[cls], ptr)) return false;
+    slab->requested[cls] -= size;
+    return true;
+}
+
+/*
+   slab_reset(slab):
+   Invalidates every object in every class and rolls the arena back
+   to where the slab began. Allocations made from the arena after
+   slab_init are invalidated too.
+*/
+static inline void slab_reset(Slab* slab)
+{
+    if (!slab || !slab->arena) return;
+    arena_reset_to(slab->arena, slab->base);
+    for (size_t i = 0; i < slab->class_count; ++i) {
+        slab->pools[i].used = 0;
+        slab->pools[i].carved = 0;
+        slab->pools[i].free_list = NULL;
+        slab->requested[i] = 0;
+        slab->failed[i] = 0;
+    }
+}
+
+/* ============================================================
+   Statistics
+   ============================================================ */
+
+typedef struct {
+    size_t class_size;      /* largest request served */
+    size_t slot_size;       /* aligned slot size */
+    size_t capacity;        /* slots reserved */
+    size_t used;            /* live objects */
+    size_t carved;          /* slots taken from the arena so far */
+    size_t idle_bytes;      /* carved but free: (carved - used) * slot_size */
+    size_t requested_bytes; /* bytes asked for by live objects */
+    size_t wasted_bytes;    /* internal fragmentation: used * slot_size - requested */
+    size_t failed;          /* allocations refused because the class was full */
+} SlabClassStats;
+
+/* Snapshot of one class; returns false if `cls` is out of range */
+static inline bool slab_class_stats(const Slab* slab, size_t cls, SlabClassStats* out)
+{
+    if (!slab || !out || cls >= slab->class_count) return false;
+    const Pool* pool = &slab->pools[cls];
+    *out = (SlabClassStats){
+        .class_size = slab->class_size[cls],
+        .slot_size = pool->object_size,
+        .capacity = pool->capacity,
+        .used = pool->used,
+        .carved = pool->carved,
+        .idle_bytes = (pool->carved - pool->used) * pool->object_size,
+        .requested_bytes = slab->requested[cls],
+        .wasted_bytes = pool->used * pool->object_size - slab->requested[cls],
+        .failed = slab->failed[cls]
+    };
+    return true;
+}
+
+static inline size_t slab_class_count(const Slab* slab) { return slab ? slab->class_count : 0; }
+
+#endif /* CANON_C_CORE_SLAB_H */
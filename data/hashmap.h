@@ -0,0 +1,357 @@
+#ifndef CANON_C_DATA_HASHMAP_H
+#define CANON_C_DATA_HASHMAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "core/arena.h"
+#include "core/cpu.h"
+#include "semantics/option.h"
+#include "semantics/error.h"
+
+/*
+    hashmap.h — Open-addressing hash map over a caller buffer
+
+    DEFINE_HASHMAP(K, V, hash_expr, eq_expr)
+      Map from K to V. hash_expr is evaluated with `a` bound to
+      `const K*` and yields an integer (up to 64 bits); eq_expr with `a`
+      and `b` bound to `const K*`, as in DEFINE_UNIQUE. K and V must be
+      single identifiers (typedef pointers first), and option_##V must
+      already exist: CANON_C_DEFINE_OPTION(V) once per value type.
+
+    Layout (Swiss-table style):
+      entries[capacity]            key/value pairs
+      ctrl[capacity + 15]          one control byte per entry:
+                                   0x80 = empty, 0..127 = 7 hash bits
+                                   (first 15 mirrored at the end, so a
+                                   16-byte group load never wraps)
+
+    Probing is linear from the key's home slot, 16 control bytes per
+    step: one SSE2 compare finds the slots whose 7-bit tag matches (keys
+    are only compared there) and a second finds an empty slot, which
+    ends the probe. Without SSE2 the group is scanned bytewise.
+
+    Deletion is tombstone-free: erase shifts later entries of the probe
+    run back into the hole (backward-shift deletion), so lookups never
+    walk over dead slots and the table does not degrade with churn.
+
+    No allocation: the buffer comes from the caller (hashmap_bytes gives
+    its size) or from an Arena. The map never grows by itself; insert
+    reports ERR_BUFFER_TOO_SMALL above 7/8 load and the caller rehashes
+    into a larger buffer, keeping the old one until rehash returns.
+
+    Costs: insert / find / erase O(1) expected, rehash O(capacity).
+*/
+
+#define HASHMAP_GROUP 16
+#define HASHMAP_EMPTY 0x80u
+
+/* Entries a map of the given capacity accepts (7/8 load) */
+static inline size_t hashmap_max_load(size_t capacity)
+{
+    return capacity - capacity / 8;
+}
+
+/* Smallest valid capacity (power of two, >= HASHMAP_GROUP) holding n entries; 0 on overflow */
+static inline size_t hashmap_capacity_for(size_t n)
+{
+    size_t capacity = HASHMAP_GROUP;
+    while (hashmap_max_load(capacity) < n) {
+        if (capacity > SIZE_MAX / 2) return 0;
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+static inline bool hashmap_capacity_valid_(size_t capacity)
+{
+    return capacity >= HASHMAP_GROUP && (capacity & (capacity - 1)) == 0;
+}
+
+static inline unsigned hashmap_bits_(size_t capacity)
+{
+    unsigned bits = 0;
+    while (((size_t)1 << bits) < capacity) ++bits;
+    return bits;
+}
+
+/* Spread the user hash so identity-like hashes still fill the table */
+static inline uint64_t hashmap_mix_(uint64_t h)
+{
+    h ^= h >> 32;
+    return h * 0x9E3779B97F4A7C15ull;
+}
+
+/* Home slot: top `bits` bits of the mixed hash */
+static inline size_t hashmap_home_(uint64_t mixed, unsigned bits)
+{
+    return (size_t)(mixed >> (64 - bits));
+}
+
+/* Tag: the 7 bits just below the home bits (independent of the slot) */
+static inline uint8_t hashmap_tag_(uint64_t mixed, unsigned bits)
+{
+    return (uint8_t)((mixed >> (57 - bits)) & 0x7F);
+}
+
+/* Bit i set where group[i] == tag */
+static inline uint32_t hashmap_group_match_(const uint8_t* group, uint8_t tag)
+{
+#if CANON_C_X86_SIMD && defined(__SSE2__)
+    __m128i g = _mm_loadu_si128((const __m128i*)group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8((char)tag)));
+#else
+    uint32_t mask = 0;
+    for (unsigned i = 0; i < HASHMAP_GROUP; ++i) mask |= (uint32_t)(group[i] == tag) << i;
+    return mask;
+#endif
+}
+
+/* Bit i set where group[i] is empty (the only control byte with the high bit) */
+static inline uint32_t hashmap_group_empty_(const uint8_t* group)
+{
+#if CANON_C_X86_SIMD && defined(__SSE2__)
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+#else
+    uint32_t mask = 0;
+    for (unsigned i = 0; i < HASHMAP_GROUP; ++i) mask |= (uint32_t)(group[i] >> 7) << i;
+    return mask;
+#endif
+}
+
+/*
+    DEFINE_HASHMAP(K, V, hash_expr, eq_expr) generates:
+
+      typedef struct { K key; V value; } hashmap_##K##_##V##_entry;
+      typedef struct { entries, ctrl, len, capacity, bits } hashmap_##K##_##V;
+
+      size_t   ..._bytes(capacity)          buffer size for capacity; 0 if invalid
+      bool     ..._init(m, buffer, capacity)
+                 capacity: power of two >= HASHMAP_GROUP; buffer of
+                 _bytes(capacity) bytes, aligned for the entry type
+      bool     ..._init_arena(m, arena, capacity)
+      Error    ..._insert(m, key, value)     insert, or assign if present
+                 ERR_OK / ERR_BUFFER_TOO_SMALL (full: rehash) / ERR_INVALID_ARG
+      option_V ..._find(m, key)
+      V*       ..._get(m, key)               in-place access; NULL if absent
+      bool     ..._contains(m, key)
+      option_V ..._erase(m, key)             removed value, or none
+      Error    ..._rehash(m, buffer, capacity)
+                 move every entry into a new buffer; m then uses it and
+                 the old buffer belongs to the caller again. ERR_OK /
+                 ERR_BUFFER_TOO_SMALL (entries do not fit) / ERR_INVALID_ARG
+      Error    ..._rehash_arena(m, arena, capacity)
+      bool     ..._next(m, size_t* cursor, const K** key, V** value)
+                 iterate (cursor starts at 0); invalidated by insert/erase
+      size_t   ..._size(m) / ..._capacity(m) / void ..._clear(m)
+*/
+#define DEFINE_HASHMAP(K, V, hash_expr, eq_expr) \
+typedef struct { \
+    K key; \
+    V value; \
+} hashmap_##K##_##V##_entry; \
+\
+typedef struct { \
+    hashmap_##K##_##V##_entry* entries; \
+    uint8_t* ctrl; \
+    size_t len; \
+    size_t capacity; \
+    unsigned bits; \
+} hashmap_##K##_##V; \
+\
+static inline uint64_t hashmap_##K##_##V##_hash_(const K* a) \
+{ \
+    return hashmap_mix_((uint64_t)(hash_expr)); \
+} \
+\
+static inline bool hashmap_##K##_##V##_eq_(const K* a, const K* b) \
+{ \
+    return (eq_expr); \
+} \
+\
+static inline size_t hashmap_##K##_##V##_bytes(size_t capacity) \
+{ \
+    if (!hashmap_capacity_valid_(capacity)) return 0; \
+    size_t ctrl = capacity + HASHMAP_GROUP - 1; \
+    if (capacity > (SIZE_MAX - ctrl) / sizeof(hashmap_##K##_##V##_entry)) return 0; \
+    return capacity * sizeof(hashmap_##K##_##V##_entry) + ctrl; \
+} \
+\
+/* Write a control byte and its mirror */ \
+static inline void hashmap_##K##_##V##_set_ctrl_(hashmap_##K##_##V* m, size_t i, uint8_t c) \
+{ \
+    m->ctrl[i] = c; \
+    if (i < HASHMAP_GROUP - 1) m->ctrl[m->capacity + i] = c; \
+} \
+\
+static inline void hashmap_##K##_##V##_clear(hashmap_##K##_##V* m) \
+{ \
+    if (!m || !m->ctrl) return; \
+    memset(m->ctrl, HASHMAP_EMPTY, m->capacity + HASHMAP_GROUP - 1); \
+    m->len = 0; \
+} \
+\
+static inline bool hashmap_##K##_##V##_init(hashmap_##K##_##V* m, void* buffer, size_t capacity) \
+{ \
+    if (!m || !buffer || hashmap_##K##_##V##_bytes(capacity) == 0) return false; \
+    m->entries = (hashmap_##K##_##V##_entry*)buffer; \
+    m->ctrl = (uint8_t*)buffer + capacity * sizeof(hashmap_##K##_##V##_entry); \
+    m->capacity = capacity; \
+    m->bits = hashmap_bits_(capacity); \
+    hashmap_##K##_##V##_clear(m); \
+    return true; \
+} \
+\
+static inline bool hashmap_##K##_##V##_init_arena(hashmap_##K##_##V* m, Arena* arena, size_t capacity) \
+{ \
+    size_t bytes = hashmap_##K##_##V##_bytes(capacity); \
+    if (!m || !arena || bytes == 0) return false; \
+    void* buffer = arena_alloc(arena, bytes); \
+    return buffer && hashmap_##K##_##V##_init(m, buffer, capacity); \
+} \
+\
+/* Slot holding key, or SIZE_MAX */ \
+static inline size_t hashmap_##K##_##V##_lookup_(const hashmap_##K##_##V* m, const K* key, uint64_t mixed) \
+{ \
+    size_t mask = m->capacity - 1; \
+    size_t pos = hashmap_home_(mixed, m->bits); \
+    uint8_t tag = hashmap_tag_(mixed, m->bits); \
+    for (size_t probed = 0; probed < m->capacity; probed += HASHMAP_GROUP) { \
+        const uint8_t* group = m->ctrl + pos; \
+        for (uint32_t match = hashmap_group_match_(group, tag); match; match &= match - 1) { \
+            size_t i = (pos + (size_t)__builtin_ctz(match)) & mask; \
+            if (hashmap_##K##_##V##_eq_(&m->entries[i].key, key)) return i; \
+        } \
+        if (hashmap_group_empty_(group)) return SIZE_MAX; \
+        pos = (pos + HASHMAP_GROUP) & mask; \
+    } \
+    return SIZE_MAX; \
+} \
+\
+/* First empty slot from the key's home (load < 1 guarantees one) */ \
+static inline size_t hashmap_##K##_##V##_free_slot_(const hashmap_##K##_##V* m, uint64_t mixed) \
+{ \
+    size_t mask = m->capacity - 1; \
+    size_t pos = hashmap_home_(mixed, m->bits); \
+    for (;;) { \
+        uint32_t empty = hashmap_group_empty_(m->ctrl + pos); \
+        if (empty) return (pos + (size_t)__builtin_ctz(empty)) & mask; \
+        pos = (pos + HASHMAP_GROUP) & mask; \
+    } \
+} \
+\
+static inline Error hashmap_##K##_##V##_insert(hashmap_##K##_##V* m, K key, V value) \
+{ \
+    if (!m || !m->ctrl) return ERR_INVALID_ARG; \
+    uint64_t mixed = hashmap_##K##_##V##_hash_(&key); \
+    size_t i = hashmap_##K##_##V##_lookup_(m, &key, mixed); \
+    if (i != SIZE_MAX) { \
+        m->entries[i].value = value; \
+        return ERR_OK; \
+    } \
+    if (m->len >= hashmap_max_load(m->capacity)) return ERR_BUFFER_TOO_SMALL; \
+    i = hashmap_##K##_##V##_free_slot_(m, mixed); \
+    m->entries[i].key = key; \
+    m->entries[i].value = value; \
+    hashmap_##K##_##V##_set_ctrl_(m, i, hashmap_tag_(mixed, m->bits)); \
+    ++m->len; \
+    return ERR_OK; \
+} \
+\
+static inline V* hashmap_##K##_##V##_get(hashmap_##K##_##V* m, K key) \
+{ \
+    if (!m || !m->ctrl || m->len == 0) return NULL; \
+    size_t i = hashmap_##K##_##V##_lookup_(m, &key, hashmap_##K##_##V##_hash_(&key)); \
+    return i == SIZE_MAX ? NULL : &m->entries[i].value; \
+} \
+\
+static inline option_##V hashmap_##K##_##V##_find(const hashmap_##K##_##V* m, K key) \
+{ \
+    if (!m || !m->ctrl || m->len == 0) return option_##V##_none(); \
+    size_t i = hashmap_##K##_##V##_lookup_(m, &key, hashmap_##K##_##V##_hash_(&key)); \
+    return i == SIZE_MAX ? option_##V##_none() : option_##V##_some(m->entries[i].value); \
+} \
+\
+static inline bool hashmap_##K##_##V##_contains(const hashmap_##K##_##V* m, K key) \
+{ \
+    if (!m || !m->ctrl || m->len == 0) return false; \
+    return hashmap_##K##_##V##_lookup_(m, &key, hashmap_##K##_##V##_hash_(&key)) != SIZE_MAX; \
+} \
+\
+static inline option_##V hashmap_##K##_##V##_erase(hashmap_##K##_##V* m, K key) \
+{ \
+    if (!m || !m->ctrl || m->len == 0) return option_##V##_none(); \
+    size_t hole = hashmap_##K##_##V##_lookup_(m, &key, hashmap_##K##_##V##_hash_(&key)); \
+    if (hole == SIZE_MAX) return option_##V##_none(); \
+    option_##V removed = option_##V##_some(m->entries[hole].value); \
+    /* Backward shift: pull each later entry of the run into the hole if \
+       the hole lies between its home and its slot */ \
+    size_t mask = m->capacity - 1; \
+    for (size_t j = (hole + 1) & mask; m->ctrl[j] != HASHMAP_EMPTY; j = (j + 1) & mask) { \
+        size_t home = hashmap_home_(hashmap_##K##_##V##_hash_(&m->entries[j].key), m->bits); \
+        if (((j - home) & mask) >= ((j - hole) & mask)) { \
+            m->entries[hole] = m->entries[j]; \
+            hashmap_##K##_##V##_set_ctrl_(m, hole, m->ctrl[j]); \
+            hole = j; \
+        } \
+    } \
+    hashmap_##K##_##V##_set_ctrl_(m, hole, HASHMAP_EMPTY); \
+    --m->len; \
+    return removed; \
+} \
+\
+static inline Error hashmap_##K##_##V##_rehash(hashmap_##K##_##V* m, void* buffer, size_t capacity) \
+{ \
+    if (!m || !m->ctrl) return ERR_INVALID_ARG; \
+    if (m->len > hashmap_max_load(capacity)) return ERR_BUFFER_TOO_SMALL; \
+    hashmap_##K##_##V next; \
+    if (!hashmap_##K##_##V##_init(&next, buffer, capacity)) return ERR_INVALID_ARG; \
+    /* Keys are already distinct: place them without lookups */ \
+    for (size_t i = 0; i < m->capacity; ++i) { \
+        if (m->ctrl[i] == HASHMAP_EMPTY) continue; \
+        uint64_t mixed = hashmap_##K##_##V##_hash_(&m->entries[i].key); \
+        size_t slot = hashmap_##K##_##V##_free_slot_(&next, mixed); \
+        next.entries[slot] = m->entries[i]; \
+        hashmap_##K##_##V##_set_ctrl_(&next, slot, hashmap_tag_(mixed, next.bits)); \
+    } \
+    next.len = m->len; \
+    *m = next; \
+    return ERR_OK; \
+} \
+\
+static inline Error hashmap_##K##_##V##_rehash_arena(hashmap_##K##_##V* m, Arena* arena, size_t capacity) \
+{ \
+    size_t bytes = hashmap_##K##_##V##_bytes(capacity); \
+    if (!m || !arena || bytes == 0) return ERR_INVALID_ARG; \
+    if (m->len > hashmap_max_load(capacity)) return ERR_BUFFER_TOO_SMALL; \
+    void* buffer = arena_alloc(arena, bytes); \
+    if (!buffer) return ERR_OUT_OF_MEMORY; \
+    return hashmap_##K##_##V##_rehash(m, buffer, capacity); \
+} \
+\
+static inline bool hashmap_##K##_##V##_next(hashmap_##K##_##V* m, size_t* cursor, const K** key, V** value) \
+{ \
+    if (!m || !m->ctrl || !cursor) return false; \
+    for (size_t i = *cursor; i < m->capacity; ++i) { \
+        if (m->ctrl[i] == HASHMAP_EMPTY) continue; \
+        if (key) *key = &m->entries[i].key; \
+        if (value) *value = &m->entries[i].value; \
+        *cursor = i + 1; \
+        return true; \
+    } \
+    *cursor = m->capacity; \
+    return false; \
+} \
+\
+static inline size_t hashmap_##K##_##V##_size(const hashmap_##K##_##V* m) \
+{ \
+    return m ? m->len : 0; \
+} \
+\
+static inline size_t hashmap_##K##_##V##_capacity(const hashmap_##K##_##V* m) \
+{ \
+    return m ? m->capacity : 0; \
+}
+
+#endif /* CANON_C_DATA_HASHMAP_H */
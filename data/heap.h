@@ -0,0 +1,340 @@
+#ifndef CANON_C_DATA_HEAP_H
+#define CANON_C_DATA_HEAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "core/memory_bulk.h"
+
+/*
+    heap.h — Bounded priority queues (4-ary heap over a caller buffer)
+
+    DEFINE_HEAP(Type, less_expr)
+      Priority queue of values; the top is the element that orders
+      first (less_expr = "a before b": a < b gives a min-heap, a > b a
+      max-heap). less_expr is evaluated with `a` and `b` bound to
+      `const Type*`, as in DEFINE_SORT.
+
+    DEFINE_INDEXED_HEAP(Type, less_expr)
+      Priority queue of ids in [0, capacity) with a Type key each, and
+      a position table so keys of queued ids can be changed in
+      O(log n): decrease_key / update / remove (Dijkstra, A*, event
+      schedulers).
+
+    Like deque.h: no allocation, fixed capacity, bool results
+    (false = full / empty / invalid argument).
+
+    4-ary layout: node i has children 4i+1 .. 4i+4. The tree is half as
+    deep as a binary heap and the four children are adjacent (one or two
+    cache lines), so large heaps take fewer misses per sift-down. Sifts
+    move a hole instead of swapping, and a sift-down prefetches the next
+    level while comparing the current one.
+
+    Costs: push / pop / decrease_key O(log n), peek O(1),
+    heapify O(n), push_bulk O(n + k) or O(k log n), whichever is cheaper.
+*/
+
+#define HEAP_ARITY 4
+
+/* ============================================================
+   Value heap
+   ============================================================ */
+
+/*
+    DEFINE_HEAP(Type, less_expr) generates:
+
+      typedef struct { Type* items; size_t len; size_t capacity; } heap_##Type;
+
+      void   heap_##Type##_init(h, buffer, capacity)
+      bool   heap_##Type##_heapify(h, buffer, len, capacity)
+               adopt buffer[0..len) and reorder it into a heap in O(n)
+      bool   heap_##Type##_push(h, item)
+      bool   heap_##Type##_push_bulk(h, items, n)       all n or nothing
+      bool   heap_##Type##_pop(h, out)
+      bool   heap_##Type##_peek(h, out)
+      bool   heap_##Type##_replace_top(h, item, out)
+               pop + push in one sift (top-k: replace the worst kept item)
+      size_t heap_##Type##_size(h) / bool heap_##Type##_empty(h) / heap_##Type##_clear(h)
+*/
+#define DEFINE_HEAP(Type, less_expr) \
+typedef struct { \
+    Type* items; \
+    size_t len; \
+    size_t capacity; \
+} heap_##Type; \
+\
+static inline bool heap_##Type##_less_(const Type* a, const Type* b) \
+{ \
+    return (less_expr); \
+} \
+\
+static inline void heap_##Type##_sift_up_(Type* items, size_t i) \
+{ \
+    Type x = items[i]; \
+    while (i > 0) { \
+        size_t parent = (i - 1) / HEAP_ARITY; \
+        if (!heap_##Type##_less_(&x, &items[parent])) break; \
+        items[i] = items[parent]; \
+        i = parent; \
+    } \
+    items[i] = x; \
+} \
+\
+static inline void heap_##Type##_sift_down_(Type* items, size_t len, size_t i, Type x) \
+{ \
+    for (;;) { \
+        size_t first = HEAP_ARITY * i + 1; \
+        if (first >= len) break; \
+        size_t last = len - first > HEAP_ARITY ? first + HEAP_ARITY : len; \
+        size_t best = first; \
+        for (size_t c = first + 1; c < last; ++c) { \
+            if (heap_##Type##_less_(&items[c], &items[best])) best = c; \
+        } \
+        if (!heap_##Type##_less_(&items[best], &x)) break; \
+        if (HEAP_ARITY * best + 1 < len) mem_prefetch(&items[HEAP_ARITY * best + 1]); \
+        items[i] = items[best]; \
+        i = best; \
+    } \
+    items[i] = x; \
+} \
+\
+static inline void heap_##Type##_build_(Type* items, size_t len) \
+{ \
+    if (len < 2) return; \
+    for (size_t i = (len - 2) / HEAP_ARITY + 1; i-- > 0;) { \
+        heap_##Type##_sift_down_(items, len, i, items[i]); \
+    } \
+} \
+\
+static inline void heap_##Type##_init(heap_##Type* h, Type* buffer, size_t capacity) \
+{ \
+    if (h && buffer && capacity > 0) { \
+        *h = (heap_##Type){ .items = buffer, .len = 0, .capacity = capacity }; \
+    } \
+} \
+\
+static inline bool heap_##Type##_heapify(heap_##Type* h, Type* buffer, size_t len, size_t capacity) \
+{ \
+    if (!h || !buffer || capacity == 0 || len > capacity) return false; \
+    *h = (heap_##Type){ .items = buffer, .len = len, .capacity = capacity }; \
+    heap_##Type##_build_(buffer, len); \
+    return true; \
+} \
+\
+static inline bool heap_##Type##_push(heap_##Type* h, Type item) \
+{ \
+    if (!h || h->len >= h->capacity) return false; \
+    h->items[h->len] = item; \
+    heap_##Type##_sift_up_(h->items, h->len++); \
+    return true; \
+} \
+\
+static inline bool heap_##Type##_push_bulk(heap_##Type* h, const Type* items, size_t n) \
+{ \
+    if (!h || (n > 0 && !items) || n > h->capacity - h->len) return false; \
+    size_t old = h->len; \
+    for (size_t i = 0; i < n; ++i) h->items[old + i] = items[i]; \
+    h->len += n; \
+    /* Rebuilding is linear in the total; sifting up is cheaper for small batches */ \
+    if (n > old) { \
+        heap_##Type##_build_(h->items, h->len); \
+    } else { \
+        for (size_t i = old; i < h->len; ++i) heap_##Type##_sift_up_(h->items, i); \
+    } \
+    return true; \
+} \
+\
+static inline bool heap_##Type##_peek(const heap_##Type* h, Type* out) \
+{ \
+    if (!h || !out || h->len == 0) return false; \
+    *out = h->items[0]; \
+    return true; \
+} \
+\
+static inline bool heap_##Type##_pop(heap_##Type* h, Type* out) \
+{ \
+    if (!h || !out || h->len == 0) return false; \
+    *out = h->items[0]; \
+    Type last = h->items[--h->len]; \
+    if (h->len > 0) heap_##Type##_sift_down_(h->items, h->len, 0, last); \
+    return true; \
+} \
+\
+static inline bool heap_##Type##_replace_top(heap_##Type* h, Type item, Type* out) \
+{ \
+    if (!h || !out || h->len == 0) return false; \
+    *out = h->items[0]; \
+    heap_##Type##_sift_down_(h->items, h->len, 0, item); \
+    return true; \
+} \
+\
+static inline size_t heap_##Type##_size(const heap_##Type* h) { return h ? h->len : 0; } \
+static inline bool heap_##Type##_empty(const heap_##Type* h) { return heap_##Type##_size(h) == 0; } \
+static inline void heap_##Type##_clear(heap_##Type* h) { if (h) h->len = 0; }
+
+/* ============================================================
+   Indexed heap (decrease-key)
+   ============================================================ */
+
+/*
+    DEFINE_INDEXED_HEAP(Type, less_expr) generates:
+
+      typedef struct {
+          size_t* heap;      ids in heap order        (capacity entries)
+          size_t* pos;       pos[id]: slot in heap, SIZE_MAX if not queued
+          Type* keys;        keys[id]: current key    (capacity entries)
+          size_t len;
+          size_t capacity;   valid ids are [0, capacity)
+      } indexed_heap_##Type;
+
+      bool indexed_heap_##Type##_init(h, heap_buf, pos_buf, keys_buf, capacity)
+             O(capacity): marks every id as not queued
+      bool indexed_heap_##Type##_push(h, id, key)          false if already queued
+      bool indexed_heap_##Type##_pop(h, out_id, out_key)   out_key optional
+      bool indexed_heap_##Type##_peek(h, out_id, out_key)  out_key optional
+      bool indexed_heap_##Type##_contains(h, id)
+      bool indexed_heap_##Type##_decrease_key(h, id, key)
+             false if id is not queued or key would move it back
+      bool indexed_heap_##Type##_update(h, id, key)
+             push, or change the key in either direction
+      bool indexed_heap_##Type##_remove(h, id)
+      size_t indexed_heap_##Type##_size(h) / bool indexed_heap_##Type##_empty(h)
+*/
+#define DEFINE_INDEXED_HEAP(Type, less_expr) \
+typedef struct { \
+    size_t* heap; \
+    size_t* pos; \
+    Type* keys; \
+    size_t len; \
+    size_t capacity; \
+} indexed_heap_##Type; \
+\
+static inline bool indexed_heap_##Type##_less_(const Type* a, const Type* b) \
+{ \
+    return (less_expr); \
+} \
+\
+static inline void indexed_heap_##Type##_sift_up_(indexed_heap_##Type* h, size_t i) \
+{ \
+    size_t id = h->heap[i]; \
+    const Type* key = &h->keys[id]; \
+    while (i > 0) { \
+        size_t parent = (i - 1) / HEAP_ARITY; \
+        size_t pid = h->heap[parent]; \
+        if (!indexed_heap_##Type##_less_(key, &h->keys[pid])) break; \
+        h->heap[i] = pid; \
+        h->pos[pid] = i; \
+        i = parent; \
+    } \
+    h->heap[i] = id; \
+    h->pos[id] = i; \
+} \
+\
+static inline void indexed_heap_##Type##_sift_down_(indexed_heap_##Type* h, size_t i) \
+{ \
+    size_t id = h->heap[i]; \
+    const Type* key = &h->keys[id]; \
+    size_t len = h->len; \
+    for (;;) { \
+        size_t first = HEAP_ARITY * i + 1; \
+        if (first >= len) break; \
+        size_t last = len - first > HEAP_ARITY ? first + HEAP_ARITY : len; \
+        size_t best = first; \
+        for (size_t c = first + 1; c < last; ++c) { \
+            if (indexed_heap_##Type##_less_(&h->keys[h->heap[c]], &h->keys[h->heap[best]])) best = c; \
+        } \
+        size_t bid = h->heap[best]; \
+        if (!indexed_heap_##Type##_less_(&h->keys[bid], key)) break; \
+        h->heap[i] = bid; \
+        h->pos[bid] = i; \
+        i = best; \
+    } \
+    h->heap[i] = id; \
+    h->pos[id] = i; \
+} \
+\
+static inline bool indexed_heap_##Type##_init( \
+    indexed_heap_##Type* h, size_t* heap_buf, size_t* pos_buf, Type* keys_buf, size_t capacity) \
+{ \
+    if (!h || !heap_buf || !pos_buf || !keys_buf || capacity == 0) return false; \
+    *h = (indexed_heap_##Type){ \
+        .heap = heap_buf, .pos = pos_buf, .keys = keys_buf, .len = 0, .capacity = capacity, \
+    }; \
+    for (size_t id = 0; id < capacity; ++id) pos_buf[id] = SIZE_MAX; \
+    return true; \
+} \
+\
+static inline bool indexed_heap_##Type##_contains(const indexed_heap_##Type* h, size_t id) \
+{ \
+    return h && id < h->capacity && h->pos[id] != SIZE_MAX; \
+} \
+\
+static inline bool indexed_heap_##Type##_push(indexed_heap_##Type* h, size_t id, Type key) \
+{ \
+    if (!h || id >= h->capacity || h->pos[id] != SIZE_MAX) return false; \
+    h->keys[id] = key; \
+    h->heap[h->len] = id; \
+    indexed_heap_##Type##_sift_up_(h, h->len++); \
+    return true; \
+} \
+\
+static inline bool indexed_heap_##Type##_peek(const indexed_heap_##Type* h, size_t* out_id, Type* out_key) \
+{ \
+    if (!h || !out_id || h->len == 0) return false; \
+    *out_id = h->heap[0]; \
+    if (out_key) *out_key = h->keys[*out_id]; \
+    return true; \
+} \
+\
+/* Take slot i out of the heap and refill it with the last entry */ \
+static inline void indexed_heap_##Type##_erase_at_(indexed_heap_##Type* h, size_t i) \
+{ \
+    h->pos[h->heap[i]] = SIZE_MAX; \
+    size_t last = h->heap[--h->len]; \
+    if (i == h->len) return; \
+    h->heap[i] = last; \
+    h->pos[last] = i; \
+    indexed_heap_##Type##_sift_down_(h, i); \
+    if (h->pos[last] == i) indexed_heap_##Type##_sift_up_(h, i); \
+} \
+\
+static inline bool indexed_heap_##Type##_pop(indexed_heap_##Type* h, size_t* out_id, Type* out_key) \
+{ \
+    if (!h || !out_id || h->len == 0) return false; \
+    *out_id = h->heap[0]; \
+    if (out_key) *out_key = h->keys[*out_id]; \
+    indexed_heap_##Type##_erase_at_(h, 0); \
+    return true; \
+} \
+\
+static inline bool indexed_heap_##Type##_decrease_key(indexed_heap_##Type* h, size_t id, Type key) \
+{ \
+    if (!indexed_heap_##Type##_contains(h, id)) return false; \
+    if (indexed_heap_##Type##_less_(&h->keys[id], &key)) return false; \
+    h->keys[id] = key; \
+    indexed_heap_##Type##_sift_up_(h, h->pos[id]); \
+    return true; \
+} \
+\
+static inline bool indexed_heap_##Type##_update(indexed_heap_##Type* h, size_t id, Type key) \
+{ \
+    if (!h || id >= h->capacity) return false; \
+    if (h->pos[id] == SIZE_MAX) return indexed_heap_##Type##_push(h, id, key); \
+    bool up = indexed_heap_##Type##_less_(&key, &h->keys[id]); \
+    h->keys[id] = key; \
+    if (up) indexed_heap_##Type##_sift_up_(h, h->pos[id]); \
+    else    indexed_heap_##Type##_sift_down_(h, h->pos[id]); \
+    return true; \
+} \
+\
+static inline bool indexed_heap_##Type##_remove(indexed_heap_##Type* h, size_t id) \
+{ \
+    if (!indexed_heap_##Type##_contains(h, id)) return false; \
+    indexed_heap_##Type##_erase_at_(h, h->pos[id]); \
+    return true; \
+} \
+\
+static inline size_t indexed_heap_##Type##_size(const indexed_heap_##Type* h) { return h ? h->len : 0; } \
+static inline bool indexed_heap_##Type##_empty(const indexed_heap_##Type* h) { return indexed_heap_##Type##_size(h) == 0; }
+
+#endif /* CANON_C_DATA_HEAP_H */
@@ -22,7 +22,7 @@
 #define CANON_C_DEFINE_RESULT_UNIT(error_type) \
     CANON_C_DEFINE_RESULT(bool, error_type)  // true = Ok(()), false not used
 
-CANON_C_DEFINE_RESULT_UNIT(const char*)  // Result<bool, const char*> ≈ Result<(), const char*>
+/* Push/pop use result_bool_constcharp ≈ Result<(), const char*> (semantics/result.h) */
 
 /* ============================================================
    Generic Vec (void*)
@@ -146,4 +146,16 @@ result_##value_type##_##error_type##_or_else( \
     return r.is_ok ? r : fallback(r.err); \
 }
 
+/* ============================================================
+   Shared instantiation: Result<(), const char*>
+   ============================================================ */
+
+/*
+    Used by data/vec.h and util/log.h. Defined once here because the
+    struct may appear only once per translation unit, and the error type
+    needs a one-token name for the generated identifiers.
+*/
+typedef const char* constcharp;
+CANON_C_DEFINE_RESULT(bool, constcharp)  // true = Ok(())
+
 #endif /* CANON_C_SEMANTICS_RESULT_H */
@@ -24,8 +24,7 @@ typedef enum {
     LOG_ERROR
 } log_level;
 
-/* Result type: success = Ok(()), failure = Err(message) */
-CANON_C_DEFINE_RESULT(bool, const char*)  // true = success
+/* Result type: result_bool_constcharp (semantics/result.h), Ok(()) on success, Err(message) on failure */
 
 /* ============================================================
    Core: Log to explicit stream
@@ -40,7 +39,7 @@ static inline result_bool_constcharp log_vfmt_to(
 )
 {
     if (!stream) return result_bool_constcharp_err("null output stream");
-    if (!fmt)    return result_bool_bool_constcharp_err("null format string");
+    if (!fmt)    return result_bool_constcharp_err("null format string");
 
     const char* prefix = "";
     switch (level) {
@@ -0,0 +1,64 @@
+#ifndef CANON_C_UTIL_MEM_STATS_H
+#define CANON_C_UTIL_MEM_STATS_H
+
+#include <stdio.h>
+#include "core/arena.h"
+#include "core/pool.h"
+#include "util/log.h"
+
+/*
+    mem_stats.h — Dump Arena / Pool statistics through log.h
+
+    Statistics are recorded only when CANON_C_MEM_STATS is defined
+    before including core/arena.h. Without it the dump functions
+    return Err and write nothing.
+
+    Typical use: run with stats on, read peak offsets, right-size arenas.
+*/
+
+/* Log one arena's statistics to an explicit stream */
+static inline result_bool_constcharp arena_stats_log_to(
+    FILE* stream,
+    const char* name,
+    const Arena* arena
+)
+{
+    ArenaStats s;
+    if (!arena) return result_bool_constcharp_err("null arena");
+    if (!arena_stats(arena, &s)) return result_bool_constcharp_err("arena statistics disabled");
+
+    return log_fmt_to(stream, LOG_INFO,
+        "arena %s: capacity=%zu offset=%zu peak=%zu allocs=%zu padding=%zu failed=%zu resets=%zu",
+        name ? name : "?", arena->capacity, arena->offset,
+        s.peak_offset, s.alloc_count, s.padding_bytes, s.failed_count, s.reset_count);
+}
+
+/* Log one pool's statistics to an explicit stream */
+static inline result_bool_constcharp pool_stats_log_to(
+    FILE* stream,
+    const char* name,
+    const Pool* pool
+)
+{
+    PoolStats s;
+    if (!pool) return result_bool_constcharp_err("null pool");
+    if (!pool_stats(pool, &s)) return result_bool_constcharp_err("pool statistics disabled");
+
+    return log_fmt_to(stream, LOG_INFO,
+        "pool %s: object_size=%zu capacity=%zu used=%zu peak=%zu allocs=%zu frees=%zu failed=%zu resets=%zu",
+        name ? name : "?", pool->object_size, pool->capacity, pool->used,
+        s.peak_used, s.alloc_count, s.free_count, s.failed_count, s.reset_count);
+}
+
+/* Default stream (stdout, like LOG_INFO) */
+static inline result_bool_constcharp arena_stats_log(const char* name, const Arena* arena)
+{
+    return arena_stats_log_to(stdout, name, arena);
+}
+
+static inline result_bool_constcharp pool_stats_log(const char* name, const Pool* pool)
+{
+    return pool_stats_log_to(stdout, name, pool);
+}
+
+#endif /* CANON_C_UTIL_MEM_STATS_H */